@@ -0,0 +1,160 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * Converts a text hardcoded traffic trace to the binary format read by
+ * noxim (see ../src/HardcodedTrace.h). The trace is read twice, so memory
+ * only depends on the number of sources, not on the length of the trace.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include "../src/HardcodedTrace.h"
+
+using namespace std;
+
+// Packets buffered for each source before being written in place
+#define BUCKET_BUFFER 256
+
+struct Bucket {
+    uint64_t next;			// next entry of the bucket in the file
+    vector<HardcodedTraceEntry> buffer;
+};
+
+static bool flushBucket(FILE *out, long entries_offset, Bucket & b)
+{
+    if (b.buffer.empty())
+	return true;
+
+    if (fseek(out, entries_offset + b.next * sizeof(HardcodedTraceEntry), SEEK_SET) != 0 ||
+	fwrite(&b.buffer[0], sizeof(HardcodedTraceEntry), b.buffer.size(), out) != b.buffer.size())
+	return false;
+
+    b.next += b.buffer.size();
+    b.buffer.clear();
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+	cerr << "Usage: " << argv[0] << " <text trace> <binary trace>" << endl;
+	return 1;
+    }
+
+    // First pass: packets of each source and number of cycles
+    ifstream fin(argv[1]);
+    if (!fin)
+    {
+	cerr << "Error: cannot open " << argv[1] << endl;
+	return 1;
+    }
+
+    vector<uint64_t> count;
+    uint64_t num_cycles = 0;
+    uint64_t pending = 0;
+    string line;
+    int src, dst;
+
+    while (getline(fin, line))
+    {
+	switch (parseHardcodedLine(line.c_str(), src, dst))
+	{
+	case HARDCODED_LINE_PACKET:
+	    if ((size_t) src >= count.size())
+		count.resize(src + 1, 0);
+	    count[src]++;
+	    pending++;
+	    break;
+	case HARDCODED_LINE_END_CYCLE:
+	    num_cycles++;
+	    pending = 0;
+	    break;
+	}
+    }
+    if (pending > 0)
+	num_cycles++;
+
+    if (num_cycles > 0xFFFFFFFFull)
+    {
+	cerr << "Error: traces longer than 2^32 cycles are not supported" << endl;
+	return 1;
+    }
+
+    // Header and index
+    HardcodedTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HARDCODED_TRACE_MAGIC, sizeof(header.magic));
+    header.num_cycles = num_cycles;
+    header.num_sources = count.size();
+
+    vector<uint64_t> first(count.size() + 1, 0);
+    for (size_t s = 0; s < count.size(); s++)
+	first[s + 1] = first[s] + count[s];
+
+    FILE *out = fopen(argv[2], "wb");
+    if (out == NULL)
+    {
+	cerr << "Error: cannot create " << argv[2] << endl;
+	return 1;
+    }
+
+    if (fwrite(&header, sizeof(header), 1, out) != 1 ||
+	fwrite(&first[0], sizeof(uint64_t), first.size(), out) != first.size())
+    {
+	cerr << "Error: cannot write " << argv[2] << endl;
+	return 1;
+    }
+    long entries_offset = ftell(out);
+
+    // Second pass: packets are written in the bucket of their source
+    vector<Bucket> buckets(count.size());
+    for (size_t s = 0; s < count.size(); s++)
+	buckets[s].next = first[s];
+
+    fin.clear();
+    fin.seekg(0);
+
+    uint32_t cycle = 0;
+    bool ok = true;
+    while (ok && getline(fin, line))
+    {
+	switch (parseHardcodedLine(line.c_str(), src, dst))
+	{
+	case HARDCODED_LINE_PACKET: {
+	    HardcodedTraceEntry entry;
+	    entry.cycle = cycle;
+	    entry.dst = dst;
+	    buckets[src].buffer.push_back(entry);
+	    if (buckets[src].buffer.size() == BUCKET_BUFFER)
+		ok = flushBucket(out, entries_offset, buckets[src]);
+	    break;
+	}
+	case HARDCODED_LINE_END_CYCLE:
+	    cycle++;
+	    break;
+	}
+    }
+
+    for (size_t s = 0; ok && s < buckets.size(); s++)
+	ok = flushBucket(out, entries_offset, buckets[s]);
+
+    if (!ok || fclose(out) != 0)
+    {
+	cerr << "Error: cannot write " << argv[2] << endl;
+	return 1;
+    }
+
+    cout << "Converted " << first.back() << " packets from " << count.size()
+	 << " sources over " << num_cycles << " cycles" << endl;
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+#!/bin/bash
+#
+# Simulator performance benchmark.
+#
+# Runs a fixed matrix of scenarios built from config_examples with the
+# -profile option and collects simulated cycles/s, delivered flits/s, peak
+# memory and elaboration time in a CSV file. Optionally compares the results
+# against a previously saved baseline and fails when any scenario regresses
+# by more than the given threshold.
+#
+# Usage: noxim_bench.sh [-o results.csv] [-b baseline.csv] [-t threshold_%]
+#                       [-s sim_cycles] [-m]
+#
+#   -o  output CSV (default bench_results.csv)
+#   -b  baseline CSV to compare against
+#   -t  maximum tolerated regression in percent (default 10)
+#   -s  simulated cycles per scenario (default 10000, warm-up is 10%)
+#   -m  also run the microbenchmarks (noxim_microbench), whose results
+#       are written and compared as <name>_micro.csv
+#
+# Environment: NOXIM (simulator binary, default ./noxim), CONFIG_DIR
+# (default ../config_examples), POWER (default power.yaml), MICROBENCH
+# (default ../other/noxim_microbench). Run it from the bin folder, as
+# run_tests.sh.
+
+NOXIM=${NOXIM:-./noxim}
+CONFIG_DIR=${CONFIG_DIR:-../config_examples}
+POWER=${POWER:-power.yaml}
+MICROBENCH=${MICROBENCH:-../other/noxim_microbench}
+
+OUT_FILE=bench_results.csv
+BASELINE=
+THRESHOLD=10
+SIM=10000
+MICRO=0
+
+while getopts "o:b:t:s:m" opt
+do
+    case $opt in
+	o) OUT_FILE=$OPTARG ;;
+	b) BASELINE=$OPTARG ;;
+	t) THRESHOLD=$OPTARG ;;
+	s) SIM=$OPTARG ;;
+	m) MICRO=1 ;;
+	*) sed -n '11,19p' $0; exit 1 ;;
+    esac
+done
+
+WARMUP=$((SIM / 10))
+
+MESH=default_configMeshNoHUB.yaml
+
+# name | configuration file | extra options
+# Near-saturation rates refer to 8-flit packets with XY routing
+SCENARIOS=(
+"mesh8x8_random_low|$MESH|-dimx 8 -dimy 8 -traffic random -pir 0.005 poisson"
+"mesh8x8_random_high|$MESH|-dimx 8 -dimy 8 -traffic random -pir 0.035 poisson"
+"mesh8x8_transpose_low|$MESH|-dimx 8 -dimy 8 -traffic transpose1 -pir 0.005 poisson"
+"mesh8x8_transpose_high|$MESH|-dimx 8 -dimy 8 -traffic transpose1 -pir 0.02 poisson"
+"mesh8x8_hotspot_low|$MESH|-dimx 8 -dimy 8 -traffic random -hs 27 0.2 -pir 0.005 poisson"
+"mesh8x8_hotspot_high|$MESH|-dimx 8 -dimy 8 -traffic random -hs 27 0.2 -pir 0.015 poisson"
+"mesh16x16_random_low|$MESH|-dimx 16 -dimy 16 -traffic random -pir 0.002 poisson"
+"mesh16x16_random_high|$MESH|-dimx 16 -dimy 16 -traffic random -pir 0.015 poisson"
+"mesh16x16_transpose_low|$MESH|-dimx 16 -dimy 16 -traffic transpose1 -pir 0.002 poisson"
+"mesh16x16_transpose_high|$MESH|-dimx 16 -dimy 16 -traffic transpose1 -pir 0.01 poisson"
+"mesh16x16_hotspot_low|$MESH|-dimx 16 -dimy 16 -traffic random -hs 136 0.1 -pir 0.002 poisson"
+"mesh16x16_hotspot_high|$MESH|-dimx 16 -dimy 16 -traffic random -hs 136 0.1 -pir 0.006 poisson"
+"mesh32x32_random_low|$MESH|-dimx 32 -dimy 32 -traffic random -pir 0.001 poisson"
+"mesh32x32_random_high|$MESH|-dimx 32 -dimy 32 -traffic random -pir 0.007 poisson"
+"mesh32x32_transpose_low|$MESH|-dimx 32 -dimy 32 -traffic transpose1 -pir 0.001 poisson"
+"mesh32x32_transpose_high|$MESH|-dimx 32 -dimy 32 -traffic transpose1 -pir 0.005 poisson"
+"mesh32x32_hotspot_low|$MESH|-dimx 32 -dimy 32 -traffic random -hs 528 0.05 -pir 0.001 poisson"
+"mesh32x32_hotspot_high|$MESH|-dimx 32 -dimy 32 -traffic random -hs 528 0.05 -pir 0.003 poisson"
+"butterfly_random_low|default_configBfly.yaml|-traffic random -pir 0.01 poisson"
+"butterfly_random_high|default_configBfly.yaml|-traffic random -pir 0.05 poisson"
+"omega_random_low|default_configOmega.yaml|-traffic random -pir 0.01 poisson"
+"omega_random_high|default_configOmega.yaml|-traffic random -pir 0.05 poisson"
+"baseline_random_low|default_configBaseline.yaml|-traffic random -pir 0.01 poisson"
+"baseline_random_high|default_configBaseline.yaml|-traffic random -pir 0.05 poisson"
+"winoc256_16h_token_packet|256_16h.yaml|-winoc -traffic random -pir 0.005 poisson"
+)
+
+echo "scenario,cycles,wall_s,elaboration_s,cycles_per_s,flits_per_s,peak_rss_kb" > $OUT_FILE
+
+TMP_FILE=`mktemp`
+FAILED=0
+
+for S in "${SCENARIOS[@]}"
+do
+    IFS='|' read NAME CONFIG OPTIONS <<< "$S"
+    echo -n "$NAME... "
+
+    $NOXIM -config $CONFIG_DIR/$CONFIG -power $POWER -seed 0 -sim $SIM -warmup $WARMUP -profile $OPTIONS > $TMP_FILE 2>&1
+    if [ $? -ne 0 ]
+    then
+	echo "FAILED"
+	FAILED=1
+	continue
+    fi
+
+    awk -v name=$NAME '
+	/^% Wall time \(s\):/                { wall = $NF }
+	/^% Simulated cycles per second:/    { cps = $NF }
+	/^% Delivered flits per second:/     { fps = $NF }
+	/^% Peak RSS \(KB\):/                { rss = $NF }
+	/^%   elaboration /                  { elab = $3 }
+	/^Noxim simulation completed/        { gsub(/[()]/, ""); cycles = $(NF-2) }
+	END { printf "%s,%s,%s,%s,%s,%s,%s\n", name, cycles, wall, elab, cps, fps, rss }
+    ' $TMP_FILE | tee -a $OUT_FILE | cut -d, -f5 | sed 's/$/ cycles\/s/'
+done
+
+rm -f $TMP_FILE
+
+if [ $MICRO -eq 1 ]
+then
+    $MICROBENCH > ${OUT_FILE%.csv}_micro.csv || FAILED=1
+    echo "Microbenchmarks written to ${OUT_FILE%.csv}_micro.csv"
+fi
+
+echo "Results written to $OUT_FILE"
+
+if [ -n "$BASELINE" ]
+then
+    # Higher is better for cycles/s and flits/s, lower is better for
+    # elaboration time and memory
+    awk -F, -v th=$THRESHOLD '
+	FNR == 1 { next }
+	NR == FNR { cps[$1] = $5; fps[$1] = $6; elab[$1] = $4; rss[$1] = $7; next }
+	!($1 in cps) { next }
+	{
+	    bad = ""
+	    if (cps[$1] > 0 && $5 < cps[$1] * (1 - th / 100)) bad = bad " cycles/s"
+	    if (fps[$1] > 0 && $6 < fps[$1] * (1 - th / 100)) bad = bad " flits/s"
+	    if (elab[$1] > 0 && $4 > elab[$1] * (1 + th / 100)) bad = bad " elaboration"
+	    if (rss[$1] > 0 && $7 > rss[$1] * (1 + th / 100)) bad = bad " memory"
+	    if (bad != "") { printf "REGRESSION %s:%s\n", $1, bad; regressions++ }
+	}
+	END { exit regressions > 0 }
+    ' $BASELINE $OUT_FILE || FAILED=1
+
+    if [ -f "${BASELINE%.csv}_micro.csv" ] && [ $MICRO -eq 1 ]
+    then
+	awk -F, -v th=$THRESHOLD '
+	    FNR == 1 { next }
+	    NR == FNR { ns[$1] = $2; next }
+	    ($1 in ns) && $2 > ns[$1] * (1 + th / 100) { printf "REGRESSION %s: %s ns/op (was %s)\n", $1, $2, ns[$1]; regressions++ }
+	    END { exit regressions > 0 }
+	' ${BASELINE%.csv}_micro.csv ${OUT_FILE%.csv}_micro.csv || FAILED=1
+    fi
+
+    if [ $FAILED -eq 0 ]
+    then
+	echo "No regressions above $THRESHOLD% with respect to $BASELINE"
+    fi
+fi
+
+exit $FAILED
@@ -0,0 +1,102 @@
+#!/bin/bash
+#
+# Divergence finder for simulator changes that must not alter the
+# cycle-level behaviour.
+#
+# Runs two simulator builds with the same options and -digest_trace, then
+# reports the first cycle and node where the hashes of the flits injected
+# or forwarded differ, together with the digest of each run. Exits with 0
+# when the runs are identical, 1 when they diverge.
+#
+# Usage: noxim_divergence.sh [-k] NOXIM_A NOXIM_B [noxim options...]
+#
+#   -k  keep the traces (divergence_a.txt, divergence_b.txt)
+#
+# Use a fixed -seed, otherwise the two runs draw different traffic.
+
+KEEP=0
+
+while getopts "k" opt
+do
+    case $opt in
+	k) KEEP=1 ;;
+	*) sed -n '11,13p' $0; exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -lt 2 ]
+then
+    sed -n '11,13p' $0
+    exit 2
+fi
+
+NOXIM_A=$1
+NOXIM_B=$2
+shift 2
+
+TRACE_A=divergence_a.txt
+TRACE_B=divergence_b.txt
+
+digest_of()
+{
+    grep "% Run digest:" | sed 's/% Run digest: //'
+}
+
+DIGEST_A=$($NOXIM_A "$@" -digest_trace $TRACE_A | digest_of)
+DIGEST_B=$($NOXIM_B "$@" -digest_trace $TRACE_B | digest_of)
+
+if [ -z "$DIGEST_A" ] || [ -z "$DIGEST_B" ]
+then
+    echo "Error: a run did not complete"
+    exit 2
+fi
+
+echo "A: $DIGEST_A"
+echo "B: $DIGEST_B"
+
+# Both traces are sorted by cycle, then by node: the first different
+# line is the first divergence
+CMP=$(cmp $TRACE_A $TRACE_B 2>&1)
+STATUS=0
+
+if [ -z "$CMP" ] && [ "$DIGEST_A" == "$DIGEST_B" ]
+then
+    echo "No divergence"
+else
+    STATUS=1
+    if echo "$CMP" | grep -q EOF
+    then
+	# One trace is a prefix of the other
+	LINES_A=$(wc -l < $TRACE_A)
+	LINES_B=$(wc -l < $TRACE_B)
+	FIRST=$(( (LINES_A < LINES_B ? LINES_A : LINES_B) + 1 ))
+    else
+	FIRST=$(echo "$CMP" | sed -n 's/.* line \([0-9]*\).*/\1/p')
+    fi
+
+    LINE_A=$(sed -n "${FIRST}p" $TRACE_A)
+    LINE_B=$(sed -n "${FIRST}p" $TRACE_B)
+
+    # The earlier of the two events is where the runs start to differ
+    read CYCLE_A NODE_A HASH_A <<< "$LINE_A"
+    read CYCLE_B NODE_B HASH_B <<< "$LINE_B"
+    if [ -z "$LINE_B" ] || { [ -n "$LINE_A" ] && { [ $CYCLE_A -lt $CYCLE_B ] ||
+	{ [ $CYCLE_A -eq $CYCLE_B ] && [ $NODE_A -le $NODE_B ]; }; }; }
+    then
+	CYCLE=$CYCLE_A; NODE=$NODE_A
+    else
+	CYCLE=$CYCLE_B; NODE=$NODE_B
+    fi
+
+    echo "First divergence at cycle $CYCLE, node $NODE"
+    echo "  A: ${LINE_A:-(no more events)}"
+    echo "  B: ${LINE_B:-(no more events)}"
+fi
+
+if [ $KEEP -eq 0 ]
+then
+    rm -f $TRACE_A $TRACE_B
+fi
+
+exit $STATUS
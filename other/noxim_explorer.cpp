@@ -19,10 +19,14 @@ using namespace std;
 #define SIMULATOR_LABEL      "simulator"
 #define REPETITIONS_LABEL    "repetitions"
 #define TMP_DIR_LABEL        "tmp"
+#define PRUNE_SAT_LABEL      "prune_saturated"
+#define PRUNE_DOM_LABEL      "prune_dominated"
 
 #define DEF_SIMULATOR        "./noxim"
 #define DEF_REPETITIONS      5
 #define DEF_TMP_DIR          "./"
+#define DEF_PRUNE_SAT        0.0
+#define DEF_PRUNE_DOM        0.0
 
 #define TMP_FILE_NAME        ".noxim_explorer.tmp"
 
@@ -34,6 +38,10 @@ using namespace std;
 #define MAX_DELAY_LABEL      "% Max delay (cycles):"
 #define TOTAL_ENERGY_LABEL   "% Total energy (J):"
 
+#define PRED_DELAY_LABEL     "% Predicted average delay (cycles):"
+#define SAT_FACTOR_LABEL     "% Saturation load factor:"
+#define SAT_THROUGHPUT_LABEL "% Predicted saturation throughput (flits/cycle/IP):"
+
 #define MATLAB_VAR_NAME      "data"
 #define MATRIX_COLUMN_WIDTH  15
 
@@ -57,6 +65,8 @@ struct TExplorerParams
   string simulator;
   string tmp_dir;
   int    repetitions;
+  double prune_saturated; // skip points whose saturation load factor is below
+  double prune_dominated; // skip points beaten by this relative margin
 };
 
 struct TSimulationResults
@@ -70,6 +80,16 @@ struct TSimulationResults
   unsigned int rflits;
 };
 
+// Prediction of the analytical model (noxim -analytical)
+struct TPrediction
+{
+  bool         saturated;
+  double       avg_delay;
+  double       saturation_factor;
+  double       saturation_throughput;
+  bool         loaded;	// false without traffic: no saturation to predict
+};
+
 map<string, string> topology_cmd;
 
 //---------------------------------------------------------------------------
@@ -475,6 +495,8 @@ bool ExtractExplorerParams(const TParameterSpace& explorer_params,
   eparams.simulator   = DEF_SIMULATOR;
   eparams.tmp_dir     = DEF_TMP_DIR;
   eparams.repetitions = DEF_REPETITIONS;
+  eparams.prune_saturated = DEF_PRUNE_SAT;
+  eparams.prune_dominated = DEF_PRUNE_DOM;
 
   for (uint i=0; i<explorer_params.size(); i++)
     {
@@ -489,6 +511,10 @@ bool ExtractExplorerParams(const TParameterSpace& explorer_params,
 	iss >> eparams.repetitions;
       else if (label == TMP_DIR_LABEL)
 	iss >> eparams.tmp_dir;
+      else if (label == PRUNE_SAT_LABEL)
+	iss >> eparams.prune_saturated;
+      else if (label == PRUNE_DOM_LABEL)
+	iss >> eparams.prune_dominated;
       else
 	{
 	  error_msg = "Invalid explorer option '" + label + "'";
@@ -651,6 +677,115 @@ bool RunSimulation(const string& cmd_base,
 
 //---------------------------------------------------------------------------
 
+bool ReadPrediction(const string& fname, 
+		    TPrediction& pred, 
+		    string& error_msg)
+{
+  ifstream fin(fname.c_str(), ios::in);
+  if (!fin)
+    {
+      error_msg = "Cannot read " + fname;
+      return false;
+    }
+
+  // Without offered load the model only reports the delay
+  bool delay_read = false;
+  int nsat = 0;
+  while (!fin.eof())
+    {
+      string line;
+      getline(fin, line);
+
+      size_t pos;      
+      pos = line.find(PRED_DELAY_LABEL);
+      if (pos != string::npos) 
+	{
+	  delay_read = true;
+	  string value = line.substr(pos + string(PRED_DELAY_LABEL).size());
+	  pred.saturated = (value.find("saturated") != string::npos);
+	  istringstream iss(value);
+	  if (!pred.saturated)
+	    iss >> pred.avg_delay;
+	  continue;
+	}
+
+      pos = line.find(SAT_FACTOR_LABEL);
+      if (pos != string::npos) 
+	{
+	  nsat++;
+	  istringstream iss(line.substr(pos + string(SAT_FACTOR_LABEL).size()));
+	  iss >> pred.saturation_factor;
+	  continue;
+	}
+
+      pos = line.find(SAT_THROUGHPUT_LABEL);
+      if (pos != string::npos) 
+	{
+	  nsat++;
+	  istringstream iss(line.substr(pos + string(SAT_THROUGHPUT_LABEL).size()));
+	  iss >> pred.saturation_throughput;
+	  continue;
+	}
+    }
+
+  if (!delay_read || (nsat != 0 && nsat != 2))
+    {
+      error_msg = "Output file " + fname + " corrupted";
+      return false;
+    }
+
+  pred.loaded = (nsat == 2);
+
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
+bool RunAnalyticalModel(const string& cmd_base,
+			const string& tmp_dir,
+			TPrediction& pred, 
+			string& error_msg)
+{
+  string tmp_fname = tmp_dir + TMP_FILE_NAME;
+  string cmd = cmd_base + " -analytical >" + tmp_fname + " 2>&1";
+
+  system(cmd.c_str());
+  if (!ReadPrediction(tmp_fname, pred, error_msg))
+    return false;
+
+  string rm_cmd = string("rm -f ") + tmp_fname;
+  system(rm_cmd.c_str());
+
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
+// True when the prediction of a point already simulated beats pred by
+// the given margin both in delay and in saturation throughput. Energy is
+// not predicted, so this pruning is only enabled on request
+bool IsDominated(const TPrediction& pred,
+		 const vector<TPrediction>& simulated,
+		 const double margin)
+{
+  for (uint i=0; i<simulated.size(); i++)
+    {
+      const TPrediction& other = simulated[i];
+
+      bool better_delay = !other.saturated &&
+	(pred.saturated || other.avg_delay * (1 + margin) <= pred.avg_delay);
+      bool better_throughput =
+	other.saturation_throughput >= pred.saturation_throughput * (1 + margin);
+
+      if (better_delay && better_throughput)
+	return true;
+    }
+
+  return false;
+}
+
+//---------------------------------------------------------------------------
+
 string ExtractFirstField(const string& s)
 {
   istringstream iss(s);
@@ -836,6 +971,10 @@ bool RunSimulations(const TConfigurationSpace& conf_space,
   TConfigurationSpace aggr_conf_space = Explore(aggragated_params_space);
 
   pair<uint,uint> sim_counter(0, conf_space.size() * aggr_conf_space.size() * eparams.repetitions);
+
+  // Predictions of the points simulated so far, per aggregated point
+  bool prune = (eparams.prune_saturated > 0 || eparams.prune_dominated > 0);
+  vector<vector<TPrediction> > simulated(aggr_conf_space.size());
   
   double start_time = GetCurrentTime();
   for (uint i=0; i<conf_space.size(); i++)
@@ -869,6 +1008,33 @@ bool RunSimulations(const TConfigurationSpace& conf_space,
 	    + def_cmd_line + " "
 	    + conf_cmd_line;
 
+	  if (prune)
+	    {
+	      TPrediction pred;
+	      if (!RunAnalyticalModel(cmd, eparams.tmp_dir, pred, error_msg))
+		return false;
+
+	      // Points without load are never pruned
+	      string reason;
+	      if (pred.loaded && pred.saturation_factor < eparams.prune_saturated)
+		reason = "predicted saturated";
+	      else if (pred.loaded && eparams.prune_dominated > 0 &&
+		       IsDominated(pred, simulated[j], eparams.prune_dominated))
+		reason = "predicted dominated";
+
+	      if (!reason.empty())
+		{
+		  cout << "# skipping " << cmd << " (" << reason << ", load factor "
+		       << pred.saturation_factor << ")" << endl;
+		  fout << "% skipped: " << aggr_cmd_line << "(" << reason << ")" << endl;
+		  sim_counter.first += eparams.repetitions;
+		  continue;
+		}
+
+	      if (pred.loaded)
+		simulated[j].push_back(pred);
+	    }
+
 	  if (!RunSimulations(start_time,
 			      sim_counter, cmd, eparams.tmp_dir, eparams.repetitions,
 			      aggr_conf_space[j], fout, error_msg))
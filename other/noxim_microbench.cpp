@@ -0,0 +1,246 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * Microbenchmarks of the hot building blocks of the simulator (buffers,
+ * reservation tables, routing functions, traffic generators). It links
+ * against the objects built in ../bin and prints one "name,ns_per_op"
+ * line for each benchmark.
+ */
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+#include "GlobalParams.h"
+#include "DataStructs.h"
+#include "Buffer.h"
+#include "ReservationTable.h"
+#include "ProcessingElement.h"
+#include "Router.h"
+#include "routingAlgorithms/RoutingAlgorithms.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+#define DEF_ITERATIONS  1000000
+#define MESH_DIM        8
+#define DELTA_TILES     64
+#define PACKET_SIZE     8
+
+// Normally defined in Main.cpp, referenced by the router
+unsigned int drained_volume;
+
+// Keeps the optimizer from removing the benchmarked calls
+volatile long sink;
+
+typedef std::chrono::steady_clock Clock;
+
+//---------------------------------------------------------------------------
+
+void report(const string & name, const Clock::time_point & start, long iterations)
+{
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    cout << name << "," << ns / iterations << endl;
+}
+
+//---------------------------------------------------------------------------
+
+void setupMesh()
+{
+    GlobalParams::topology = TOPOLOGY_MESH;
+    GlobalParams::topology_type = TOPOLOGY_TYPE_MESH;
+    GlobalParams::mesh_dim_x = MESH_DIM;
+    GlobalParams::mesh_dim_y = MESH_DIM;
+}
+
+void setupDelta()
+{
+    GlobalParams::topology = TOPOLOGY_BUTTERFLY;
+    GlobalParams::topology_type = TOPOLOGY_TYPE_DELTA;
+    GlobalParams::n_delta_tiles = DELTA_TILES;
+    GlobalParams::delta_radix = 2;
+    GlobalParams::n_delta_stages = log2(DELTA_TILES);
+    GlobalParams::n_delta_switches = DELTA_TILES / 2;
+}
+
+//---------------------------------------------------------------------------
+
+void benchBuffer(long iterations)
+{
+    Buffer buffer;
+    Flit flit;
+
+    buffer.SetMaxBufferSize(GlobalParams::buffer_depth);
+
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; i++)
+    {
+	flit.sequence_no = i;
+	buffer.Push(flit);
+	if (buffer.IsFull())
+	    while (!buffer.IsEmpty())
+		sink += buffer.Pop().sequence_no;
+    }
+    report("buffer_push_pop", start, iterations);
+}
+
+//---------------------------------------------------------------------------
+
+void benchReservationTable(long iterations)
+{
+    ReservationTable rtable;
+
+    rtable.setSize(DIRECTIONS + 2);
+
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; i++)
+    {
+	TReservation r;
+	r.input = i % (DIRECTIONS + 1);
+	r.vc = 0;
+	int out = (i + 1) % (DIRECTIONS + 1);
+
+	if (rtable.checkReservation(r, out) == RT_AVAILABLE)
+	{
+	    rtable.reserve(r, out);
+	    sink += rtable.getReservations(r.input).size();
+	    rtable.release(r, out);
+	}
+	rtable.updateIndex();
+    }
+    report("reservation_table", start, iterations);
+}
+
+//---------------------------------------------------------------------------
+
+void benchRouting(const string & algorithm, long iterations)
+{
+    RoutingAlgorithm *routing = RoutingAlgorithms::get(algorithm);
+    int n_tiles = MESH_DIM * MESH_DIM;
+
+    if (routing == 0)
+    {
+	cerr << "Routing algorithm " << algorithm << " not found" << endl;
+	return;
+    }
+
+    // Destinations are precomputed so that rand() is not benchmarked
+    vector<RouteData> rds(1024);
+    for (size_t i = 0; i < rds.size(); i++)
+    {
+	rds[i].current_id = rand() % n_tiles;
+	rds[i].src_id = rds[i].current_id;
+	rds[i].dst_id = rand() % n_tiles;
+	rds[i].dir_in = DIRECTION_LOCAL;
+	rds[i].vc_id = 0;
+    }
+
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; i++)
+	sink += routing->route(NULL, rds[i & 1023]).size();
+    report("routing_" + algorithm, start, iterations);
+}
+
+void benchDeltaRouting(long iterations)
+{
+    RoutingAlgorithm *routing = RoutingAlgorithms::get("DELTA");
+
+    setupDelta();
+
+    // DELTA routing reads the path tables of the topology through the router
+    TopologyGraph topology;
+    topology.buildDelta(GlobalParams::topology, DELTA_TILES, GlobalParams::delta_radix);
+    topology.computePathTables();
+
+    GlobalParams::routing_algorithm = "DELTA";
+    GlobalParams::selection_strategy = "RANDOM";
+    Router router("delta_router");
+    router.topology = &topology;
+
+    int switches = GlobalParams::n_delta_stages * GlobalParams::n_delta_switches;
+
+    vector<RouteData> rds(1024);
+    for (size_t i = 0; i < rds.size(); i++)
+    {
+	// switch ids follow the cores (see coord2Id)
+	rds[i].current_id = DELTA_TILES + rand() % switches;
+	rds[i].src_id = rand() % DELTA_TILES;
+	rds[i].dst_id = rand() % DELTA_TILES;
+	rds[i].dir_in = 0;
+	rds[i].vc_id = 0;
+    }
+
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; i++)
+	sink += routing->route(&router, rds[i & 1023]).size();
+    report("routing_DELTA", start, iterations);
+
+    setupMesh();
+}
+
+//---------------------------------------------------------------------------
+
+void benchTraffic(ProcessingElement & pe, const string & name, Packet (ProcessingElement::*traffic)(), long iterations)
+{
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; i++)
+    {
+	pe.local_id = i % (MESH_DIM * MESH_DIM);
+	sink += (pe.*traffic)().dst_id;
+    }
+    report("traffic_" + name, start, iterations);
+}
+
+//---------------------------------------------------------------------------
+
+int sc_main(int arg_num, char *arg_vet[])
+{
+    long iterations = DEF_ITERATIONS;
+
+    if (arg_num > 1)
+	iterations = atol(arg_vet[1]);
+
+    if (iterations <= 0)
+    {
+	cerr << "Usage: " << arg_vet[0] << " [iterations]" << endl;
+	return 1;
+    }
+
+    srand(0);
+
+    setupMesh();
+    GlobalParams::buffer_depth = 4;
+    GlobalParams::n_virtual_channels = 1;
+    GlobalParams::min_packet_size = PACKET_SIZE;
+    GlobalParams::max_packet_size = PACKET_SIZE;
+    GlobalParams::clock_period_ps = 1000;
+
+    cout << "benchmark,ns_per_op" << endl;
+
+    benchBuffer(iterations);
+    benchReservationTable(iterations);
+
+    benchRouting("XY", iterations);
+    benchRouting("WEST_FIRST", iterations);
+    benchRouting("NORTH_LAST", iterations);
+    benchRouting("NEGATIVE_FIRST", iterations);
+    benchRouting("ODD_EVEN", iterations);
+    benchDeltaRouting(iterations);
+
+    ProcessingElement pe("pe");
+    benchTraffic(pe, "random", &ProcessingElement::trafficRandom, iterations);
+    benchTraffic(pe, "transpose1", &ProcessingElement::trafficTranspose1, iterations);
+    benchTraffic(pe, "transpose2", &ProcessingElement::trafficTranspose2, iterations);
+    benchTraffic(pe, "bitreversal", &ProcessingElement::trafficBitReversal, iterations);
+    benchTraffic(pe, "shuffle", &ProcessingElement::trafficShuffle, iterations);
+    benchTraffic(pe, "butterfly", &ProcessingElement::trafficButterfly, iterations);
+
+    return 0;
+}
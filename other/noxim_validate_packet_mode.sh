@@ -0,0 +1,117 @@
+#!/bin/bash
+#
+# Validation of the packet-granularity mode (-packet_mode).
+#
+# Runs the wired scenarios of noxim_bench.sh both at flit level and in
+# packet mode with the same seed, and reports average delay, throughput
+# and wall time of each run in a CSV file together with the relative error
+# of the packet mode and its speed-up. Fails when any error exceeds the
+# given threshold. The default report is the one kept in doc/ as the
+# reference accuracy of the mode: rerun it when the packet model changes.
+#
+# Usage: noxim_validate_packet_mode.sh [-o report.csv] [-t threshold_%]
+#                                      [-s sim_cycles] [-z packet_size]
+#
+#   -o  output CSV (default ../doc/packet_mode_validation.csv)
+#   -t  maximum tolerated relative error in percent (default 10)
+#   -s  simulated cycles per scenario (default 20000, warm-up is 10%)
+#   -z  packet size in flits (default 8)
+#
+# Environment: NOXIM (simulator binary, default ./noxim), CONFIG_DIR
+# (default ../config_examples), POWER (default power.yaml). Run it from the
+# bin folder, as run_tests.sh.
+
+NOXIM=${NOXIM:-./noxim}
+CONFIG_DIR=${CONFIG_DIR:-../config_examples}
+POWER=${POWER:-power.yaml}
+
+OUT_FILE=../doc/packet_mode_validation.csv
+THRESHOLD=10
+SIM=20000
+SIZE=8
+
+while getopts "o:t:s:z:" opt
+do
+    case $opt in
+	o) OUT_FILE=$OPTARG ;;
+	t) THRESHOLD=$OPTARG ;;
+	s) SIM=$OPTARG ;;
+	z) SIZE=$OPTARG ;;
+	*) sed -n '12,18p' $0; exit 1 ;;
+    esac
+done
+
+WARMUP=$((SIM / 10))
+
+MESH=default_configMeshNoHUB.yaml
+
+# name | configuration file | extra options
+# Near-saturation rates refer to 8-flit packets with XY routing
+SCENARIOS=(
+"mesh8x8_random_low|$MESH|-dimx 8 -dimy 8 -traffic random -pir 0.005 poisson"
+"mesh8x8_random_high|$MESH|-dimx 8 -dimy 8 -traffic random -pir 0.035 poisson"
+"mesh8x8_transpose_low|$MESH|-dimx 8 -dimy 8 -traffic transpose1 -pir 0.005 poisson"
+"mesh8x8_transpose_high|$MESH|-dimx 8 -dimy 8 -traffic transpose1 -pir 0.02 poisson"
+"mesh8x8_hotspot_low|$MESH|-dimx 8 -dimy 8 -traffic random -hs 27 0.2 -pir 0.005 poisson"
+"mesh8x8_hotspot_high|$MESH|-dimx 8 -dimy 8 -traffic random -hs 27 0.2 -pir 0.015 poisson"
+"mesh8x8_random_vc4|$MESH|-dimx 8 -dimy 8 -vc 4 -traffic random -pir 0.02 poisson"
+"mesh16x16_random_low|$MESH|-dimx 16 -dimy 16 -traffic random -pir 0.002 poisson"
+"mesh16x16_random_high|$MESH|-dimx 16 -dimy 16 -traffic random -pir 0.015 poisson"
+"mesh16x16_transpose_high|$MESH|-dimx 16 -dimy 16 -traffic transpose1 -pir 0.01 poisson"
+"butterfly_random_low|default_configBfly.yaml|-traffic random -pir 0.01 poisson"
+"butterfly_random_high|default_configBfly.yaml|-traffic random -pir 0.05 poisson"
+"omega_random_low|default_configOmega.yaml|-traffic random -pir 0.01 poisson"
+"omega_random_high|default_configOmega.yaml|-traffic random -pir 0.05 poisson"
+"baseline_random_low|default_configBaseline.yaml|-traffic random -pir 0.01 poisson"
+"baseline_random_high|default_configBaseline.yaml|-traffic random -pir 0.05 poisson"
+)
+
+echo "scenario,flit_delay,packet_delay,delay_err_%,flit_throughput,packet_throughput,throughput_err_%,speedup" > $OUT_FILE
+
+TMP_FILE=`mktemp`
+FAILED=0
+
+# Prints "delay throughput wall_time" of a run
+run()
+{
+    $NOXIM -config $CONFIG_DIR/$1 -power $POWER -seed 0 -sim $SIM -warmup $WARMUP -size $SIZE $SIZE -profile $2 > $TMP_FILE 2>&1 || return 1
+
+    awk '
+	/^% Global average delay \(cycles\):/     { delay = $NF }
+	/^% Network throughput \(flits\/cycle\):/ { thr = $NF }
+	/^% Wall time \(s\):/                     { wall = $NF }
+	END { print delay, thr, wall }
+    ' $TMP_FILE
+}
+
+for S in "${SCENARIOS[@]}"
+do
+    IFS='|' read NAME CONFIG OPTIONS <<< "$S"
+    echo -n "$NAME... "
+
+    FLIT=`run $CONFIG "$OPTIONS"` && PACKET=`run $CONFIG "$OPTIONS -packet_mode"`
+    if [ $? -ne 0 ]
+    then
+	echo "FAILED"
+	FAILED=1
+	continue
+    fi
+
+    echo $NAME $FLIT $PACKET | awk -v th=$THRESHOLD '
+	function err(ref, x) { return ref != 0 ? 100 * (x - ref) / ref : 0 }
+	function abs(x) { return x < 0 ? -x : x }
+	{
+	    de = err($2, $5); te = err($3, $6)
+	    printf "%s,%s,%s,%.2f,%s,%s,%.2f,%.2f\n", $1, $2, $5, de, $3, $6, te, ($7 > 0 ? $4 / $7 : 0)
+	    if (abs(de) > th || abs(te) > th)
+		exit 1
+	}
+    ' | tee -a $OUT_FILE | awk -F, '{ printf "delay %s%%, throughput %s%%, speed-up %sx\n", $4, $7, $8 }'
+    [ ${PIPESTATUS[1]} -eq 0 ] || { echo "  error above $THRESHOLD%"; FAILED=1; }
+done
+
+rm -f $TMP_FILE
+
+echo "Report written to $OUT_FILE"
+
+exit $FAILED
@@ -0,0 +1,269 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the analytical performance model
+ */
+
+#include "AnalyticalModel.h"
+#include "NoC.h"
+#include "FunctionalNetwork.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+AnalyticalModel::AnalyticalModel(NoC * _noc)
+{
+    noc = _noc;
+
+    const TopologyGraph & topology = noc->topology;
+    n_endpoints = topology.n_endpoints;
+    n_links = topology.links.size();
+
+    out_link.assign(topology.nodes.size() * DIRECTIONS, NOT_VALID);
+    for (int l = 0; l < n_links; l++)
+	out_link[topology.links[l].src * DIRECTIONS + topology.links[l].src_port] = l;
+
+    arrival.assign(channels(), 0.0);
+    next.resize(channels());
+    injected = 0.0;
+
+    // Uniform packet size in [min, max]
+    int range = GlobalParams::max_packet_size - GlobalParams::min_packet_size + 1;
+    avg_size = (GlobalParams::min_packet_size + GlobalParams::max_packet_size) / 2.0;
+    size_var = (range * range - 1) / 12.0;
+
+    // A packet longer than the buffer keeps the upstream channel while it
+    // waits downstream. Virtual channels let other packets overtake it
+    blocking = max(0.0, 1.0 - GlobalParams::buffer_depth / avg_size) / GlobalParams::n_virtual_channels;
+
+    saturated = false;
+    avg_delay = zero_load_delay = avg_hops = 0.0;
+    max_utilisation = 0.0;
+    bottleneck = NOT_VALID;
+    saturation_factor = 0.0;
+    elapsed_ms = 0.0;
+}
+
+void AnalyticalModel::trafficOf(ProcessingElement * pe, vector<pair<int, double> > & dst_rate) const
+{
+    dst_rate.clear();
+
+    if (GlobalParams::traffic_type == TRAFFIC_TYPE_TABLE_BASED) {
+	noc->gttable.getAverageRates(pe->local_id, dst_rate);
+	return;
+    }
+
+    if (GlobalParams::traffic_type == TRAFFIC_TYPE_HARDCODED) {
+	// Packets of the trace within the simulated cycles
+	size_t count;
+	const HardcodedTraceEntry * own = noc->ghtable.trafficOf(pe->local_id, count);
+
+	map<int, double> rate;
+	for (size_t i = 0; i < count && own[i].cycle < (uint32_t) GlobalParams::simulation_time; i++)
+	    rate[own[i].dst] += 1.0 / GlobalParams::simulation_time;
+	dst_rate.assign(rate.begin(), rate.end());
+	return;
+    }
+
+    // Synthetic traffic: destination frequencies of a sample of packets
+    double rate = pe->injectionRate();
+    if (rate <= 0)
+	return;
+
+    map<int, int> count;
+    for (int i = 0; i < ANALYTICAL_TRAFFIC_SAMPLES; i++)
+	count[pe->syntheticPacket().dst_id]++;
+
+    for (map<int, int>::const_iterator i = count.begin(); i != count.end(); i++)
+	dst_rate.push_back(pair<int, double>(i->first, rate * i->second / ANALYTICAL_TRAFFIC_SAMPLES));
+}
+
+void AnalyticalModel::addFlow(const int src, const int dst, const double rate)
+{
+    if (src == dst || rate <= 0)
+	return;
+
+    const TopologyGraph & topology = noc->topology;
+
+    injected += rate;
+
+    // Packets/cycle of the flow on the channels reached after each hop
+    map<int, double> frontier;
+    frontier[injectionChannel(src)] = rate;
+    arrival[injectionChannel(src)] += rate;
+
+    for (unsigned int hops = 0; !frontier.empty(); hops++) {
+	if (hops > topology.nodes.size()) {
+	    cerr << "Error: the routing from " << src << " to " << dst << " does not reach the destination" << endl;
+	    exit(1);
+	}
+
+	map<int, double> reached;
+	for (map<int, double>::const_iterator i = frontier.begin(); i != frontier.end(); i++) {
+	    int c = i->first;
+	    int node = c < n_links ? topology.links[c].dst : src;
+
+	    if (node == dst) {
+		arrival[ejectionChannel(dst)] += i->second;
+		next[c][ejectionChannel(dst)] += i->second;
+		continue;
+	    }
+
+	    RouteData route_data;
+	    route_data.current_id = node;
+	    route_data.src_id = src;
+	    route_data.dst_id = dst;
+	    route_data.dir_in = c < n_links ? topology.links[c].dst_port : DIRECTION_LOCAL;
+	    route_data.vc_id = 0;
+
+	    Router * router = noc->tile[node]->r;
+	    vector<int> directions = router->routingAlgorithm->route(router, route_data);
+	    double share = i->second / directions.size();
+
+	    for (unsigned int d = 0; d < directions.size(); d++) {
+		int l = out_link[node * DIRECTIONS + directions[d]];
+		assert(l != NOT_VALID);
+
+		arrival[l] += share;
+		next[c][l] += share;
+		reached[l] += share;
+	    }
+	}
+	frontier.swap(reached);
+    }
+}
+
+bool AnalyticalModel::solve(const double factor, vector<double> & w) const
+{
+    w.assign(channels(), 0.0);
+
+    // Gauss-Seidel on the service times: with deadlock-free routing the
+    // channel dependencies are acyclic and this converges in as many
+    // iterations as the longest path
+    for (int it = 0; it < ANALYTICAL_MAX_ITERATIONS; it++) {
+	double change = 0.0;
+
+	for (int c = 0; c < channels(); c++) {
+	    if (arrival[c] <= 0)
+		continue;
+
+	    double service = avg_size;
+	    for (map<int, double>::const_iterator i = next[c].begin(); i != next[c].end(); i++)
+		service += blocking * i->second / arrival[c] * w[i->first];
+
+	    double lambda = factor * arrival[c];
+	    double rho = lambda * service;
+	    if (rho >= 1)
+		return false;
+
+	    // Pollaczek-Khinchine mean waiting time
+	    double waiting = lambda * (service * service + size_var) / (2 * (1 - rho));
+	    change = max(change, fabs(waiting - w[c]));
+	    w[c] = waiting;
+	}
+
+	if (change < ANALYTICAL_TOLERANCE)
+	    return true;
+    }
+
+    return false;
+}
+
+void AnalyticalModel::evaluate()
+{
+    Profiler::Clock::time_point start = Profiler::Clock::now();
+
+    // Channel loads
+    vector<pair<int, double> > dst_rate;
+    for (int src = 0; src < n_endpoints; src++) {
+	trafficOf(noc->tile[src]->pe, dst_rate);
+	for (unsigned int i = 0; i < dst_rate.size(); i++)
+	    addFlow(src, dst_rate[i].first, dst_rate[i].second);
+    }
+
+    for (int c = 0; c < channels(); c++)
+	if (arrival[c] * avg_size > max_utilisation) {
+	    max_utilisation = arrival[c] * avg_size;
+	    bottleneck = c;
+	}
+
+    if (injected <= 0)
+	return;
+
+    // Latency at the offered load
+    double link_arrivals = 0.0;
+    for (int l = 0; l < n_links; l++)
+	link_arrivals += arrival[l];
+    avg_hops = link_arrivals / injected;
+    zero_load_delay = ZERO_LOAD_HOP_CYCLES * avg_hops + avg_size - 1;
+
+    saturated = !solve(1.0, waiting);
+    if (!saturated) {
+	double total_waiting = 0.0;
+	for (int c = 0; c < channels(); c++)
+	    total_waiting += arrival[c] * waiting[c];
+	avg_delay = zero_load_delay + total_waiting / injected;
+    }
+
+    // The blocking only lowers the bound given by the busiest channel
+    vector<double> w;
+    double low = 0.0;
+    double high = 1.0 / max_utilisation;
+    for (int i = 0; i < ANALYTICAL_BISECTIONS; i++) {
+	double factor = (low + high) / 2;
+	if (solve(factor, w))
+	    low = factor;
+	else
+	    high = factor;
+    }
+    saturation_factor = low;
+
+    elapsed_ms = std::chrono::duration<double, std::milli>(Profiler::Clock::now() - start).count();
+}
+
+void AnalyticalModel::showChannel(std::ostream & out, const int c) const
+{
+    if (c < n_links) {
+	const TopologyLink & link = noc->topology.links[c];
+	out << "(" << link.src << "." << link.src_port << ")->(" << link.dst << "." << link.dst_port << ")";
+    } else if (c < ejectionChannel(0))
+	out << "injection of " << c - n_links;
+    else
+	out << "ejection of " << c - ejectionChannel(0);
+}
+
+void AnalyticalModel::showResults(std::ostream & out) const
+{
+    double offered = injected * avg_size / n_endpoints;
+
+    out << endl;
+    out << "% Analytical model" << endl;
+    out << "% Offered load (flits/cycle/IP): " << offered << endl;
+    out << "% Average hops: " << avg_hops << endl;
+    out << "% Zero-load delay (cycles): " << zero_load_delay << endl;
+    if (injected <= 0)
+	out << "% Predicted average delay (cycles): " << 0 << endl;
+    else if (saturated)
+	out << "% Predicted average delay (cycles): saturated" << endl;
+    else
+	out << "% Predicted average delay (cycles): " << avg_delay << endl;
+
+    out << "% Max channel utilisation: " << max_utilisation;
+    if (bottleneck != NOT_VALID) {
+	out << " (";
+	showChannel(out, bottleneck);
+	out << ")";
+    }
+    out << endl;
+
+    if (injected > 0) {
+	out << "% Saturation load factor: " << saturation_factor << endl;
+	out << "% Predicted saturation throughput (flits/cycle/IP): " << saturation_factor * offered << endl;
+    }
+    out << "% Model evaluation time (ms): " << elapsed_ms << endl;
+}
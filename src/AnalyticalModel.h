@@ -0,0 +1,93 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the analytical performance model
+ */
+
+#ifndef __NOXIMANALYTICALMODEL_H__
+#define __NOXIMANALYTICALMODEL_H__
+
+#include <iostream>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+// Destinations drawn from each PE to estimate a synthetic traffic matrix
+#define ANALYTICAL_TRAFFIC_SAMPLES 1000
+// Fixed-point iterations of the blocking model, and their tolerance [cycles]
+#define ANALYTICAL_MAX_ITERATIONS  100
+#define ANALYTICAL_TOLERANCE       1e-6
+// Bisection steps on the load factor of saturation
+#define ANALYTICAL_BISECTIONS      30
+
+struct NoC;
+struct ProcessingElement;
+
+// Queueing model of the network, built from the same configuration as a
+// simulation. The traffic of every source is routed through the routing
+// algorithm of the routers (adaptive routings split it evenly among the
+// admissible outputs) to obtain the packet rate of each channel. Each
+// channel is then an M/G/1 server whose service time is the packet length
+// plus the share of the downstream waiting that backs up into it, when a
+// packet does not fit in the buffers of the next router. Channels are the
+// links of the topology graph, followed by the injection and the ejection
+// channel of every endpoint
+class AnalyticalModel {
+
+  public:
+
+    AnalyticalModel(NoC * _noc);
+
+    // Builds the channel loads, solves the model at the offered load and
+    // bisects the load factor at which the network saturates
+    void evaluate();
+
+    void showResults(std::ostream & out) const;
+
+  private:
+
+    NoC *noc;
+    int n_endpoints;
+    int n_links;
+
+    vector<int> out_link;		// [node * DIRECTIONS + port], NOT_VALID if unconnected
+
+    vector<double> arrival;		// packets/cycle of each channel
+    vector<map<int, double> > next;	// packets/cycle from a channel to the next one
+    double injected;			// packets/cycle of the whole network
+
+    double avg_size;			// flits
+    double size_var;			// flits^2
+    double blocking;			// share of the downstream waiting seen upstream
+
+    // Results
+    vector<double> waiting;		// cycles, at the offered load
+    bool saturated;
+    double avg_delay;
+    double zero_load_delay;
+    double avg_hops;
+    double max_utilisation;		// flits/cycle of the busiest channel
+    int bottleneck;
+    double saturation_factor;		// offered load multiplier at saturation
+    double elapsed_ms;
+
+    int channels() const { return n_links + 2 * n_endpoints; }
+    int injectionChannel(const int id) const { return n_links + id; }
+    int ejectionChannel(const int id) const { return n_links + n_endpoints + id; }
+
+    void trafficOf(ProcessingElement * pe, vector<pair<int, double> > & dst_rate) const;
+    void addFlow(const int src, const int dst, const double rate);
+
+    // Solves the waiting times with the rates scaled by factor. Returns
+    // false if some channel saturates
+    bool solve(const double factor, vector<double> & w) const;
+
+    void showChannel(std::ostream & out, const int c) const;
+};
+
+#endif
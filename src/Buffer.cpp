@@ -14,6 +14,7 @@
 Buffer::Buffer()
 {
   SetMaxBufferSize(GlobalParams::buffer_depth);
+  used_slots = 0;
   max_occupancy = 0;
   hold_time = 0.0;
   last_event = 0.0;
@@ -141,7 +142,9 @@ unsigned int Buffer::GetMaxBufferSize() const
 
 bool Buffer::IsFull() const
 {
-  return buffer.size() == max_buffer_size;
+  // In packet mode a head enters as long as a slot is free, as in
+  // wormhole, and the rest of its packet may exceed the depth
+  return used_slots >= max_buffer_size;
 }
 
 bool Buffer::IsEmpty() const
@@ -165,13 +168,15 @@ void Buffer::Push(const Flit & flit)
 
   if (IsFull())
     Drop(flit);
-  else
+  else {
     buffer.push(flit);
+    used_slots += SlotsOf(flit);
+  }
   
   UpdateMeanOccupancy();
 
-  if (max_occupancy < buffer.size())
-    max_occupancy = buffer.size();
+  if (max_occupancy < used_slots)
+    max_occupancy = used_slots;
 }
 
 Flit Buffer::Pop()
@@ -185,6 +190,7 @@ Flit Buffer::Pop()
   else {
     f = buffer.front();
     buffer.pop();
+    used_slots -= SlotsOf(f);
   }
 
   UpdateMeanOccupancy();
@@ -206,17 +212,17 @@ Flit Buffer::Front() const
 
 unsigned int Buffer::Size() const
 {
-  return buffer.size();
+  return used_slots;
 }
 
 unsigned int Buffer::getCurrentFreeSlots() const
 {
-  return (GetMaxBufferSize() - Size());
+  return IsFull() ? 0 : GetMaxBufferSize() - used_slots;
 }
 
 void Buffer::SaveOccupancyAndTime()
 {
-  previous_occupancy = buffer.size();
+  previous_occupancy = used_slots;
   hold_time = (sc_time_stamp().to_double() / GlobalParams::clock_period_ps) - last_event;
   last_event = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
 }
@@ -228,7 +234,7 @@ void Buffer::UpdateMeanOccupancy()
     return;
 
   mean_occupancy = mean_occupancy * (hold_time_sum/(hold_time_sum+hold_time)) +
-    (1.0/(hold_time_sum+hold_time)) * hold_time * buffer.size();
+    (1.0/(hold_time_sum+hold_time)) * hold_time * used_slots;
 
   hold_time_sum += hold_time;
 }
@@ -240,3 +246,11 @@ void Buffer::ShowStats(std::ostream & out)
   else
     out << "\t\t";
 }
+
+BufferBank::BufferBank()
+{
+  n_vcs = GlobalParams::n_virtual_channels;
+  assert(n_vcs >= 1 && n_vcs <= MAX_VIRTUAL_CHANNELS);
+
+  buffers = new Buffer[n_vcs];
+}
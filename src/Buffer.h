@@ -45,10 +45,20 @@ class Buffer {
 
     unsigned int Size() const;
 
+    // Slots taken by a flit: 1, or in packet mode those of the whole
+    // packet carried by the head, up to the buffer depth
+    unsigned int SlotsOf(const Flit & flit) const {
+	if (!GlobalParams::packet_mode)
+	    return 1;
+	return flit.sequence_length < max_buffer_size ? flit.sequence_length : max_buffer_size;
+    }
+
     void ShowStats(std::ostream & out);
 
     void Disable();
 
+    bool IsEnabled() const { return true_buffer; }
+
 
     void Print();
     
@@ -72,6 +82,7 @@ class Buffer {
     unsigned int max_buffer_size;
 
     queue < Flit > buffer;
+    unsigned int used_slots;	// buffer.size() unless in packet mode
 
     unsigned int max_occupancy;
     double hold_time, last_event, hold_time_sum;
@@ -82,7 +93,40 @@ class Buffer {
     void UpdateMeanOccupancy();
 };
 
-typedef Buffer BufferBank[MAX_VIRTUAL_CHANNELS];
+// The buffers of the virtual channels of a port. Only the configured
+// number of VCs (GlobalParams::n_virtual_channels) is allocated, hence the
+// configuration must be loaded before any BufferBank is built
+class BufferBank {
+
+  public:
+
+    BufferBank();
+
+    ~BufferBank() {
+	delete [] buffers;
+    }
+
+    inline Buffer & operator [](const int vc) {
+	assert(vc >= 0 && vc < n_vcs);
+	return buffers[vc];
+    }
+
+    inline const Buffer & operator [](const int vc) const {
+	assert(vc >= 0 && vc < n_vcs);
+	return buffers[vc];
+    }
+
+    int size() const { return n_vcs; }
+
+  private:
+
+    Buffer *buffers;
+    int n_vcs;
+
+    // Not copyable
+    BufferBank(const BufferBank &);
+    BufferBank & operator =(const BufferBank &);
+};
 
 
 #endif
@@ -9,40 +9,63 @@
  * to forward configuration to every sub-block
  */
 #include "Channel.h"
-void Channel::b_transport( int id, tlm::tlm_generic_payload& trans, sc_time& delay )
+tlm::tlm_sync_enum Channel::nb_transport_fw( int id, tlm::tlm_generic_payload& trans,
+					     tlm::tlm_phase& phase, sc_time& delay )
 {
-
-    // the total transmission delay is due to TLM Initiator delay +
-    // channel delay
-    delay += sc_time(this->cc_flit_transmission_delay_ps, SC_PS);
-
     assert (id < (int)targ_socket.size());
+    assert (phase == tlm::BEGIN_REQ);
 
-    // Forward path
-    sc_dt::uint64 address = trans.get_address();
     sc_dt::uint64 masked_address;
-    unsigned int target_nr = decode_address( address, masked_address);
+    unsigned int target_nr = decode_address( trans.get_address(), masked_address);
 
     if (target_nr < init_socket.size())
     {
-	// Modify address within transaction
-	trans.set_address( masked_address );
-
-
 	accountWirelessRxPower();
 
 	powerManager(target_nr,trans);
 
-	// Realize the delay annotated onto the transport call
-	wait(delay);
+	// the total transmission delay is due to TLM Initiator delay +
+	// channel delay
+	m_id_map[&trans] = id;
+	m_peq.notify(trans, phase, delay + sc_time(this->cc_flit_transmission_delay_ps, SC_PS));
 
-	// Forward transaction to appropriate target
-	init_socket[target_nr]->b_transport(trans, delay);
+	phase = tlm::END_REQ;
+	return tlm::TLM_UPDATED;
+    }
 
+    // No hub at that address: the transaction completes at once with an
+    // error, so that the initiator does not wait for a response
+    trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+    phase = tlm::END_RESP;
+    return tlm::TLM_COMPLETED;
+}
 
-	// Replace original address
-	trans.set_address( address );
-    }
+void Channel::peq_cb(tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase)
+{
+    // Forward path
+    sc_dt::uint64 address = trans.get_address();
+    sc_dt::uint64 masked_address;
+    unsigned int target_nr = decode_address( address, masked_address);
+
+    // Modify address within transaction
+    trans.set_address( masked_address );
+
+    // Forward transaction to appropriate target
+    sc_time delay = SC_ZERO_TIME;
+    init_socket[target_nr]->b_transport(trans, delay);
+
+    // Replace original address
+    trans.set_address( address );
+
+    // Backward path: the transmission is over
+    std::map <tlm::tlm_generic_payload*, unsigned int>::iterator it = m_id_map.find(&trans);
+    assert(it != m_id_map.end());
+    unsigned int id = it->second;
+    m_id_map.erase(it);
+
+    tlm::tlm_phase bw_phase = tlm::BEGIN_RESP;
+    delay = SC_ZERO_TIME;
+    targ_socket[id]->nb_transport_bw(trans, bw_phase, delay);
 }
 
 
@@ -52,10 +52,10 @@ struct Channel: sc_module
   int local_id; // Unique ID
 
   Channel(sc_module_name nm, int id)
-  : sc_module(nm), targ_socket("targ_socket"), init_socket("init_socket")
+  : sc_module(nm), targ_socket("targ_socket"), init_socket("init_socket"), m_peq(this, &Channel::peq_cb)
   {
     local_id = id;
-    targ_socket.register_b_transport(       this, &Channel::b_transport);
+    targ_socket.register_nb_transport_fw(   this, &Channel::nb_transport_fw);
     targ_socket.register_get_direct_mem_ptr(this, &Channel::get_direct_mem_ptr);
     targ_socket.register_transport_dbg(     this, &Channel::transport_dbg);
 
@@ -77,8 +77,11 @@ struct Channel: sc_module
 
   Power power;
 
-  // Tagged TLM-2 blocking transport method
-  virtual void b_transport( int id, tlm::tlm_generic_payload& trans, sc_time& delay );
+  // Tagged TLM-2 non-blocking transport method: the flit is delivered to
+  // the target hub, and the response sent back, once the transmission
+  // delay has elapsed
+  virtual tlm::tlm_sync_enum nb_transport_fw( int id, tlm::tlm_generic_payload& trans,
+					      tlm::tlm_phase& phase, sc_time& delay );
 
   // Tagged TLM-2 forward DMI method
   virtual bool get_direct_mem_ptr(int id,
@@ -127,7 +130,12 @@ struct Channel: sc_module
       int flit_transmission_cycles;
       int cc_flit_transmission_delay_ps; // clock compliant
 
+  // initiator socket id of each transaction in flight
   std::map <tlm::tlm_generic_payload*, unsigned int> m_id_map;
+  // transactions in flight, released at the end of their transmission
+  tlm_utils::peq_with_cb_and_phase<Channel> m_peq;
+
+   void peq_cb(tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase);
 
    void powerManager(unsigned int hub_dst_index, tlm::tlm_generic_payload& trans);
    void accountWirelessRxPower();
@@ -9,6 +9,8 @@
  */
 
 #include "ConfigurationManager.h"
+#include "Topology.h"
+#include "DataStructs.h"
 #include <systemc.h> //Included for the function time() 
 
 YAML::Node config;
@@ -64,11 +66,14 @@ void loadConfiguration() {
         //GlobalParams::mesh_dim_y = readParam<int>(config, "mesh_dim_y");
         GlobalParams::n_delta_tiles = readParam<int>(config, "n_delta_tiles");
     }
+    GlobalParams::delta_radix = readParam<int>(config, "delta_radix", 2);
+    GlobalParams::netlist_filename = readParam<string>(config, "netlist_filename", "");
 
     GlobalParams::r2r_link_length = readParam<double>(config, "r2r_link_length");
     GlobalParams::r2h_link_length = readParam<double>(config, "r2h_link_length");
     GlobalParams::buffer_depth = readParam<int>(config, "buffer_depth");
     GlobalParams::flit_size = readParam<int>(config, "flit_size");
+    GlobalParams::packet_mode = readParam<bool>(config, "packet_mode", false);
     GlobalParams::min_packet_size = readParam<int>(config, "min_packet_size");
     GlobalParams::max_packet_size = readParam<int>(config, "max_packet_size");
     GlobalParams::routing_algorithm = readParam<string>(config, "routing_algorithm");
@@ -79,6 +84,10 @@ void loadConfiguration() {
     GlobalParams::traffic_distribution = readParam<string>(config, "traffic_distribution");
     GlobalParams::traffic_table_filename = readParam<string>(config, "traffic_table_filename");
     GlobalParams::traffic_hardcoded_filename = readParam<string>(config, "traffic_hardcoded_filename");
+    GlobalParams::traffic_dependency_filename = readParam<string>(config, "traffic_dependency_filename", "");
+    GlobalParams::dependency_window = readParam<int>(config, "dependency_window", 100000);
+    GlobalParams::source_queue_size = readParam<int>(config, "source_queue_size", 0);
+    GlobalParams::source_queue_policy = readParam<string>(config, "source_queue_policy", SOURCE_QUEUE_STALL);
     GlobalParams::clock_period_ps = readParam<int>(config, "clock_period_ps");
     GlobalParams::simulation_time = readParam<int>(config, "simulation_time");
     GlobalParams::n_virtual_channels = readParam<int>(config, "n_virtual_channels");
@@ -93,6 +102,16 @@ void loadConfiguration() {
     GlobalParams::use_winoc = readParam<bool>(config, "use_winoc");
     GlobalParams::winoc_dst_hops = readParam<int>(config, "winoc_dst_hops",0);
     GlobalParams::use_powermanager = readParam<bool>(config, "use_wirxsleep");
+    GlobalParams::adaptive_precision = readParam<double>(config, "adaptive_precision", 0.0);
+    GlobalParams::adaptive_batch_cycles = readParam<int>(config, "adaptive_batch_cycles", 100);
+    GlobalParams::sweep_pir_min = readParam<double>(config, "sweep_pir_min", 0.0);
+    GlobalParams::sweep_pir_max = readParam<double>(config, "sweep_pir_max", 0.0);
+    GlobalParams::sweep_pir_step = readParam<double>(config, "sweep_pir_step", 0.0);
+    GlobalParams::sweep_bisections = readParam<int>(config, "sweep_bisections", 4);
+
+    GlobalParams::sample_period = readParam<int>(config, "sample_period", 0);
+    GlobalParams::sample_warm_cycles = readParam<int>(config, "sample_warm_cycles", 1000);
+    GlobalParams::sample_measure_cycles = readParam<int>(config, "sample_measure_cycles", 1000);
     
 
     set<int> channelSet;
@@ -202,6 +221,8 @@ void showHelp(char selfname[])
          << "\t-buffer_ft N\t\tSet the depth of hub buffers to tile [flits]" << endl
          << "\t-buffer_antenna N\tSet the depth of hub antenna buffers (RX/TX) [flits]" << endl
 	 << "\t-vc N\t\t\tNumber of virtual channels" << endl
+         << "\t-packet_mode\t\tMove packets as a whole, holding each link for as many cycles as their flits" << endl
+         << "\t\t\t\t(faster, approximates the body flits of wormhole switching)" << endl
          << "\t-winoc\t\t\tEnable radio hub wireless transmission" << endl
          << "\t-winoc_dst_hops\t\t\tMax number of hops between target RadioHub and destination node" << endl
          << "\t-wirxsleep\t\tEnable radio hub wireless power manager" << endl
@@ -209,9 +230,13 @@ void showHelp(char selfname[])
          << "\t-flit N\t\t\tSet the flit size [bit]" << endl
          << "\t-topology TYPE\t\tSet the topology to one of the following:" << endl
          << "\t\tMESH\t\t2D Mesh" << endl
-         << "\t\tBUTTERFLY\tDelta network Butterfly (radix 2)" << endl
+         << "\t\tBUTTERFLY\tDelta network Butterfly" << endl
          << "\t\tBASELINE\tDelta network Baseline" << endl
          << "\t\tOMEGA\t\tDelta network Omega" << endl
+         << "\t\tNETLIST\t\tMulti-stage network read from the file given with -netlist" << endl
+         << "\t-dtiles N\t\tSet the number of cores of delta topologies" << endl
+         << "\t-radix K\t\tSet the switch radix of delta topologies [2.." << DIRECTIONS << "] (default 2)" << endl
+         << "\t-netlist FILENAME\tRead the topology from the netlist file FILENAME (implies -topology NETLIST)" << endl
          << "\t-routing TYPE\t\tSet the routing algorithm to one of the following:" << endl
          << "\t\tXY\t\tXY routing algorithm" << endl
          << "\t\tWEST_FIRST\tWest-First routing algorithm" << endl
@@ -239,6 +264,13 @@ void showHelp(char selfname[])
          << "\t\tbutterfly\tButterfly traffic distribution" << endl
          << "\t\tshuffle\t\tShuffle traffic distribution" << endl
          <<	"\t\ttable FILENAME\tTraffic Table Based traffic distribution with table in the specified file" << endl
+         <<	"\t\tdependency FILENAME\tClosed-loop replay of the packets, with their dependencies, in the specified trace" << endl
+         << "\t-dep_window N\t\tPackets of the dependency trace kept in memory (default 100000)" << endl
+         << "\t-squeue N POLICY\tBound the source queue of each PE to N packets (0 for unbounded, default) with" << endl
+         << "\t\t\t\tPOLICY applied to the packets generated while the queue is full:" << endl
+         << "\t\tSTALL\t\tSuspend the generation until there is room" << endl
+         << "\t\tDROP\t\tDiscard the packet and count it as lost" << endl
+         << "\t\tRESAMPLE\tRetry the packet in the following cycles with the injection probability" << endl
          << "\t-hs ID P\t\tAdd node ID to hotspot nodes, with percentage P (0..1) (Only for 'random' traffic)" << endl
          << "\t-warmup N\t\tStart to collect statistics after N cycles" << endl
          << "\t-seed N\t\t\tSet the seed of the random generator (default time())" << endl
@@ -246,8 +278,26 @@ void showHelp(char selfname[])
          << "\t-show_buf_stats\t\tShow buffers statistics" << endl
          << "\t-volume N\t\tStop the simulation when either the maximum number of cycles has been reached or N flits have" << endl
          << "\t\t\t\tbeen delivered" << endl
-         << "\t-asciimonitor\t\tShow status of the network while running (experimental)" << endl
+         << "\t-asciimonitor\t\tShow live heatmaps of buffer occupancy, link utilisation and router throughput" << endl
+         << "\t-profile\t\tReport simulator wall time, speed, memory and time breakdown, with periodic progress" << endl
+         << "\t-analytical\t\tDo not simulate: predict average delay, channel loads and saturation throughput" << endl
+         << "\t\t\t\twith a queueing model of the configured network" << endl
+         << "\t-partitions N\t\tSimulate the mesh with N local processes, each one a band of rows" << endl
+         << "\t-partition_numa\t\tPin the processes of -partitions to the NUMA nodes in round robin" << endl
+         << "\t-record_injection FILENAME\tSave the offered packets (cycle, source, destination, size, VC) as a" << endl
+         << "\t\t\t\tbinary trace, replayed with -traffic hardcoded FILENAME" << endl
+         << "\t-digest\t\t\tShow a hash of every flit injected and forwarded (cycle, node, ports, VC, flit)" << endl
+         << "\t-digest_check HEX\tAlso compare the digest with HEX and exit with an error if they differ" << endl
+         << "\t-digest_trace FILENAME\tAlso save the hash of each node in each cycle (see other/noxim_divergence.sh)" << endl
          << "\t-sim N\t\t\tRun for the specified simulation time [cycles]" << endl
+         << "\t-precision R\t\tDetect the warm-up and stop as soon as average delay and throughput reach a" << endl
+         << "\t\t\t\trelative 95% confidence half-width R (e.g. 0.02), or on saturation. -sim is the cycle cap" << endl
+         << "\t-batch N\t\tInitial batch length for -precision [cycles]" << endl
+         << "\t-sweep MIN MAX STEP\tMeasure the load-latency curve stepping the PIR from MIN to MAX on the running" << endl
+         << "\t\t\t\tnetwork until saturation. -warmup and -sim give the length of each level" << endl
+         << "\t-bisect N\t\tNumber of bisection steps between the last stable and the first saturated PIR" << endl
+         << "\t-sample P W M\t\tEvery P cycles simulate W warming and M measurement cycles in detail, and" << endl
+         << "\t\t\t\tfast-forward the rest of the period on a functional network. -sim is the run length" << endl
          << endl
          << "If you find this program useful please don't forget to mention in your paper Maurizio Palesi <maurizio.palesi@unikore.it>" << endl
          <<	"If you find this program useless please feel free to complain with Davide Patti <davide.patti@dieei.unict.it>" << endl
@@ -280,7 +330,86 @@ void showConfig()
 
 void checkConfiguration()
 {
-	if (GlobalParams::topology==TOPOLOGY_MESH)
+	// Resolve the strings compared by the per-cycle and per-packet paths
+	if (GlobalParams::topology == TOPOLOGY_MESH)
+		GlobalParams::topology_type = TOPOLOGY_TYPE_MESH;
+	else if (GlobalParams::topology == TOPOLOGY_BASELINE  ||
+		 GlobalParams::topology == TOPOLOGY_BUTTERFLY ||
+		 GlobalParams::topology == TOPOLOGY_OMEGA)
+		GlobalParams::topology_type = TOPOLOGY_TYPE_DELTA;
+	else if (GlobalParams::topology == TOPOLOGY_NETLIST)
+		GlobalParams::topology_type = TOPOLOGY_TYPE_NETLIST;
+	else
+	{
+		cerr << "Error: invalid topology " << GlobalParams::topology << endl;
+		exit(1);
+	}
+
+	const string & traffic = GlobalParams::traffic_distribution;
+	if (traffic == TRAFFIC_RANDOM)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_RANDOM;
+	else if (traffic == TRAFFIC_TRANSPOSE1)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_TRANSPOSE1;
+	else if (traffic == TRAFFIC_TRANSPOSE2)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_TRANSPOSE2;
+	else if (traffic == TRAFFIC_BIT_REVERSAL)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_BIT_REVERSAL;
+	else if (traffic == TRAFFIC_SHUFFLE)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_SHUFFLE;
+	else if (traffic == TRAFFIC_BUTTERFLY)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_BUTTERFLY;
+	else if (traffic == TRAFFIC_LOCAL)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_LOCAL;
+	else if (traffic == TRAFFIC_ULOCAL)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_ULOCAL;
+	else if (traffic == TRAFFIC_TABLE_BASED)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_TABLE_BASED;
+	else if (traffic == TRAFFIC_HARDCODED)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_HARDCODED;
+	else if (traffic == TRAFFIC_DEPENDENCY)
+		GlobalParams::traffic_type = TRAFFIC_TYPE_DEPENDENCY;
+	else
+	{
+		cerr << "Error: invalid traffic distribution " << traffic << endl;
+		exit(1);
+	}
+
+	const string & policy = GlobalParams::source_queue_policy;
+	if (policy == SOURCE_QUEUE_STALL)
+		GlobalParams::source_queue_policy_type = SOURCE_QUEUE_POLICY_STALL;
+	else if (policy == SOURCE_QUEUE_DROP)
+		GlobalParams::source_queue_policy_type = SOURCE_QUEUE_POLICY_DROP;
+	else if (policy == SOURCE_QUEUE_RESAMPLE)
+		GlobalParams::source_queue_policy_type = SOURCE_QUEUE_POLICY_RESAMPLE;
+	else
+	{
+		cerr << "Error: invalid source queue policy " << policy << endl;
+		exit(1);
+	}
+
+#ifdef FIXED_ROUTING
+	if (GlobalParams::routing_algorithm != NOXIM_STR(FIXED_ROUTING))
+	{
+		cerr << "Error: this build only supports the " << NOXIM_STR(FIXED_ROUTING) << " routing algorithm" << endl;
+		exit(1);
+	}
+#endif
+#ifdef FIXED_SELECTION
+	if (GlobalParams::selection_strategy != NOXIM_STR(FIXED_SELECTION))
+	{
+		cerr << "Error: this build only supports the " << NOXIM_STR(FIXED_SELECTION) << " selection strategy" << endl;
+		exit(1);
+	}
+#endif
+#ifdef FIXED_TRAFFIC
+	if (GlobalParams::traffic_type != NOXIM_CAT(TRAFFIC_TYPE_, FIXED_TRAFFIC))
+	{
+		cerr << "Error: this build only supports the TRAFFIC_" << NOXIM_STR(FIXED_TRAFFIC) << " traffic distribution" << endl;
+		exit(1);
+	}
+#endif
+
+	if (GlobalParams::topology_type == TOPOLOGY_TYPE_MESH)
 	{
 		if (GlobalParams::mesh_dim_x <= 1) {
 			cerr << "Error: dimx must be greater than 1" << endl;
@@ -299,16 +428,40 @@ void checkConfiguration()
 	}
 	else // other delta topologies
 	{
-		int x = GlobalParams::n_delta_tiles;
-		while( x != 1)
+		if (GlobalParams::topology_type == TOPOLOGY_TYPE_NETLIST)
 		{
-			//checks whether a number is divisible by 2
-			if(x % 2 != 0)
+			// The size of the network is declared in the netlist itself
+			if (!TopologyGraph::readNetlistSize(GlobalParams::netlist_filename.c_str(),
+							    GlobalParams::n_delta_tiles,
+							    GlobalParams::n_delta_stages,
+							    GlobalParams::n_delta_switches))
+			{
+				cerr << "Error: cannot read the size of netlist \"" << GlobalParams::netlist_filename << "\"" << endl;
+				exit(1);
+			}
+		}
+		else
+		{
+			if (GlobalParams::delta_radix < 2 || GlobalParams::delta_radix > DIRECTIONS)
+			{
+				cerr << "Error: delta_radix must be in [2," << DIRECTIONS << "]" << endl;
+				exit(1);
+			}
+
+			int x = GlobalParams::n_delta_tiles;
+			int stages = 0;
+			while( x > 1 && x % GlobalParams::delta_radix == 0)
+			{
+				x /= GlobalParams::delta_radix;
+				stages++;
+			}
+			if (x != 1 || stages == 0)
 			{
-				cerr << "Error: n_delta_tiles must be a power of 2 " << endl;
+				cerr << "Error: n_delta_tiles must be a power of delta_radix " << endl;
 				exit(1);
 			}
-			x /= 2;
+			GlobalParams::n_delta_stages = stages;
+			GlobalParams::n_delta_switches = GlobalParams::n_delta_tiles / GlobalParams::delta_radix;
 		}
 		if (GlobalParams::routing_algorithm!="DELTA")
 		{
@@ -317,12 +470,19 @@ void checkConfiguration()
 		}
 	}
 
+	// Node ids travel in the narrow fields of the flit
+	int n_nodes;
+	if (GlobalParams::topology == TOPOLOGY_MESH)
+		n_nodes = GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y;
+	else
+		n_nodes = GlobalParams::n_delta_tiles + GlobalParams::n_delta_stages * GlobalParams::n_delta_switches;
+	if (n_nodes > FLIT_MAX_NODES)
+	{
+		cerr << "Error: networks of more than " << FLIT_MAX_NODES << " nodes are not supported" << endl;
+		exit(1);
+	}
+
 	if (GlobalParams::winoc_dst_hops>0) {
-		if (GlobalParams::topology != TOPOLOGY_BUTTERFLY)
-		{
-			cerr << "Error: winoc_dst_hops currently supported only in BUTTERFLY topology" << endl;
-            exit(1);
-        }
 		if (!GlobalParams::use_winoc)
 		{
 			cerr << "Error: winoc_dst_hops makes sense only when -winoc is enabled!" << endl;
@@ -334,10 +494,34 @@ void checkConfiguration()
 	cerr << "Error: buffer must be >= 1" << endl;
 	exit(1);
     }
+    if (GlobalParams::dependency_window < 1) {
+	cerr << "Error: dependency window must be >= 1" << endl;
+	exit(1);
+    }
+    if (GlobalParams::source_queue_size < 0) {
+	cerr << "Error: source queue size must be >= 0 (0 for unbounded)" << endl;
+	exit(1);
+    }
+    // Packets of a dependency trace cannot be lost or delayed at random,
+    // or the trace would never complete
+    if (GlobalParams::source_queue_size > 0 &&
+	GlobalParams::traffic_distribution == TRAFFIC_DEPENDENCY &&
+	GlobalParams::source_queue_policy != SOURCE_QUEUE_STALL) {
+	cerr << "Error: dependency traffic only supports the " << SOURCE_QUEUE_STALL << " source queue policy" << endl;
+	exit(1);
+    }
     if (GlobalParams::flit_size <= 0) {
 	cerr << "Error: flit_size must be > 0" << endl;
 	exit(1);
     }
+    // Hubs and the wireless MAC move single flits
+    if (GlobalParams::packet_mode && GlobalParams::use_winoc) {
+	cerr << "Error: -packet_mode cannot be used with -winoc" << endl;
+	exit(1);
+    }
+    // Until doc/packet_mode_validation.csv is committed
+    if (GlobalParams::packet_mode)
+	cerr << "Warning: the error of -packet_mode against flit-level results has not been validated yet" << endl;
 
     if (GlobalParams::min_packet_size < 2 ||
 	GlobalParams::max_packet_size < 2) {
@@ -345,6 +529,11 @@ void checkConfiguration()
 	exit(1);
     }
 
+    if (GlobalParams::max_packet_size > FLIT_MAX_PACKET_SIZE) {
+	cerr << "Error: packet size must be <= " << FLIT_MAX_PACKET_SIZE << endl;
+	exit(1);
+    }
+
     if (GlobalParams::min_packet_size >
 	GlobalParams::max_packet_size) {
 	cerr << "Error: min packet size must be less than max packet size"
@@ -443,6 +632,140 @@ void checkConfiguration()
 	exit(1);
     }
 
+    if (GlobalParams::adaptive_precision < 0 || GlobalParams::adaptive_precision >= 1)
+    {
+	cerr << "Error: precision must be in the range [0,1)" << endl;
+	exit(1);
+    }
+    if (GlobalParams::adaptive_precision > 0)
+    {
+	if (GlobalParams::adaptive_batch_cycles <= 0)
+	{
+	    cerr << "Error: batch length must be positive" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::max_volume_to_be_drained > 0)
+	{
+	    cerr << "Error: -precision cannot be combined with -volume" << endl;
+	    exit(1);
+	}
+    }
+
+    if (GlobalParams::sweep_pir_max > 0)
+    {
+	if (GlobalParams::sweep_pir_min < 0 || GlobalParams::sweep_pir_min > GlobalParams::sweep_pir_max ||
+	    GlobalParams::sweep_pir_max > 1 || GlobalParams::sweep_pir_step <= 0)
+	{
+	    cerr << "Error: -sweep requires 0 <= MIN <= MAX <= 1 and STEP > 0" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::traffic_distribution == TRAFFIC_TABLE_BASED ||
+	    GlobalParams::traffic_distribution == TRAFFIC_HARDCODED ||
+	    GlobalParams::traffic_distribution == TRAFFIC_DEPENDENCY)
+	{
+	    cerr << "Error: -sweep cannot be used with table based, hardcoded or dependency traffic" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::adaptive_precision > 0 || GlobalParams::max_volume_to_be_drained > 0)
+	{
+	    cerr << "Error: -sweep cannot be combined with -precision or -volume" << endl;
+	    exit(1);
+	}
+    }
+
+    if (GlobalParams::sample_period < 0)
+    {
+	cerr << "Error: sampling period must be >= 0" << endl;
+	exit(1);
+    }
+    if (GlobalParams::sample_period > 0)
+    {
+	if (GlobalParams::sample_warm_cycles < 0 || GlobalParams::sample_measure_cycles <= 0 ||
+	    GlobalParams::sample_period < GlobalParams::sample_warm_cycles + GlobalParams::sample_measure_cycles)
+	{
+	    cerr << "Error: -sample requires W >= 0, M > 0 and P >= W + M" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::traffic_distribution == TRAFFIC_TABLE_BASED ||
+	    GlobalParams::traffic_distribution == TRAFFIC_DEPENDENCY)
+	{
+	    cerr << "Error: -sample cannot be used with table based or dependency traffic" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::sweep_pir_max > 0 || GlobalParams::adaptive_precision > 0 ||
+	    GlobalParams::max_volume_to_be_drained > 0)
+	{
+	    cerr << "Error: -sample cannot be combined with -sweep, -precision or -volume" << endl;
+	    exit(1);
+	}
+    }
+
+    if (GlobalParams::analytical_mode)
+    {
+	if (GlobalParams::use_winoc)
+	{
+	    cerr << "Error: -analytical cannot be used with -winoc" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::traffic_distribution == TRAFFIC_DEPENDENCY)
+	{
+	    cerr << "Error: -analytical cannot be used with dependency traffic" << endl;
+	    exit(1);
+	}
+    }
+
+    if (GlobalParams::partitions < 0 || GlobalParams::partitions > GlobalParams::mesh_dim_y)
+    {
+	cerr << "Error: the number of partitions must be in the range [0," << GlobalParams::mesh_dim_y << "]" << endl;
+	exit(1);
+    }
+    if (GlobalParams::partitions > 0)
+    {
+	if (GlobalParams::topology != TOPOLOGY_MESH)
+	{
+	    cerr << "Error: -partitions is only supported on mesh topologies" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::use_winoc || GlobalParams::use_powermanager ||
+	    GlobalParams::traffic_distribution == TRAFFIC_DEPENDENCY)
+	{
+	    cerr << "Error: -partitions cannot be used with -winoc, -wirxsleep or dependency traffic" << endl;
+	    exit(1);
+	}
+	// All the processes must stop at the same cycle, and the results
+	// are only gathered at the end of a plain run
+	if (GlobalParams::max_volume_to_be_drained > 0 || GlobalParams::adaptive_precision > 0 ||
+	    GlobalParams::sweep_pir_max > 0 || GlobalParams::sample_period > 0 ||
+	    GlobalParams::analytical_mode)
+	{
+	    cerr << "Error: -partitions cannot be combined with -volume, -precision, -sweep, -sample or -analytical" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::ascii_monitor || GlobalParams::trace_mode || GlobalParams::show_buffer_stats)
+	{
+	    cerr << "Error: -partitions cannot be combined with -asciimonitor, -trace or -show_buf_stats" << endl;
+	    exit(1);
+	}
+    }
+
+    // Only plain runs inject every cycle through the PEs
+    if (!GlobalParams::injection_record_filename.empty() &&
+	(GlobalParams::sweep_pir_max > 0 || GlobalParams::sample_period > 0 ||
+	 GlobalParams::analytical_mode || GlobalParams::partitions > 1))
+    {
+	cerr << "Error: -record_injection cannot be combined with -sweep, -sample, -analytical or -partitions" << endl;
+	exit(1);
+    }
+
+    // The digest covers the whole network of a plain run
+    if (GlobalParams::digest_mode &&
+	(GlobalParams::sweep_pir_max > 0 || GlobalParams::sample_period > 0 ||
+	 GlobalParams::analytical_mode || GlobalParams::partitions > 1))
+    {
+	cerr << "Error: -digest cannot be combined with -sweep, -sample, -analytical or -partitions" << endl;
+	exit(1);
+    }
+
     if (GlobalParams::ascii_monitor)
     {
 #ifdef DEBUG
@@ -476,6 +799,13 @@ void parseCmdLine(int arg_num, char *arg_vet[])
 
 	    else if (!strcmp(arg_vet[i], "-dtiles"))
 		GlobalParams::n_delta_tiles = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-radix"))
+		GlobalParams::delta_radix = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-netlist"))
+	    {
+		GlobalParams::topology = TOPOLOGY_NETLIST;
+		GlobalParams::netlist_filename = arg_vet[++i];
+	    }
 
 	    else if (!strcmp(arg_vet[i], "-buffer"))
 		GlobalParams::buffer_depth = atoi(arg_vet[++i]);
@@ -489,6 +819,8 @@ void parseCmdLine(int arg_num, char *arg_vet[])
 		GlobalParams::n_virtual_channels = (atoi(arg_vet[++i]));
 	    else if (!strcmp(arg_vet[i], "-flit"))
 		GlobalParams::flit_size = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-packet_mode"))
+		GlobalParams::packet_mode = true;
 	    else if (!strcmp(arg_vet[i], "-winoc")) 
 		GlobalParams::use_winoc = true;
 	    else if (!strcmp(arg_vet[i], "-winoc_dst_hops")) 
@@ -578,12 +910,23 @@ void parseCmdLine(int arg_num, char *arg_vet[])
 		    GlobalParams::traffic_distribution =
 			TRAFFIC_HARDCODED;
 		    GlobalParams::traffic_hardcoded_filename = arg_vet[++i];
+		} else if (!strcmp(traffic, "dependency")) {
+		    GlobalParams::traffic_distribution =
+			TRAFFIC_DEPENDENCY;
+		    GlobalParams::traffic_dependency_filename = arg_vet[++i];
 		} else if (!strcmp(traffic, "local")) {
 		    GlobalParams::traffic_distribution = TRAFFIC_LOCAL;
 		    GlobalParams::locality=atof(arg_vet[++i]);
 		}
 		else assert(false);
 	    } 
+	    else if (!strcmp(arg_vet[i], "-dep_window"))
+		GlobalParams::dependency_window = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-squeue"))
+	    {
+		GlobalParams::source_queue_size = atoi(arg_vet[++i]);
+		GlobalParams::source_queue_policy = arg_vet[++i];
+	    }
 	    else if (!strcmp(arg_vet[i], "-hs")) 
 	    {
 		int node = atoi(arg_vet[++i]);
@@ -604,8 +947,48 @@ void parseCmdLine(int arg_num, char *arg_vet[])
 		    atoi(arg_vet[++i]);
 	    else if (!strcmp(arg_vet[i], "-sim"))
 		GlobalParams::simulation_time = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-precision"))
+		GlobalParams::adaptive_precision = atof(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-batch"))
+		GlobalParams::adaptive_batch_cycles = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-sweep"))
+	    {
+		GlobalParams::sweep_pir_min = atof(arg_vet[++i]);
+		GlobalParams::sweep_pir_max = atof(arg_vet[++i]);
+		GlobalParams::sweep_pir_step = atof(arg_vet[++i]);
+	    }
+	    else if (!strcmp(arg_vet[i], "-bisect"))
+		GlobalParams::sweep_bisections = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-sample"))
+	    {
+		GlobalParams::sample_period = atoi(arg_vet[++i]);
+		GlobalParams::sample_warm_cycles = atoi(arg_vet[++i]);
+		GlobalParams::sample_measure_cycles = atoi(arg_vet[++i]);
+	    }
 	    else if (!strcmp(arg_vet[i], "-asciimonitor")) 
 		GlobalParams::ascii_monitor = true;
+	    else if (!strcmp(arg_vet[i], "-profile"))
+		GlobalParams::profile_mode = true;
+	    else if (!strcmp(arg_vet[i], "-analytical"))
+		GlobalParams::analytical_mode = true;
+	    else if (!strcmp(arg_vet[i], "-partitions"))
+		GlobalParams::partitions = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-partition_numa"))
+		GlobalParams::partition_numa = true;
+	    else if (!strcmp(arg_vet[i], "-record_injection"))
+		GlobalParams::injection_record_filename = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-digest"))
+		GlobalParams::digest_mode = true;
+	    else if (!strcmp(arg_vet[i], "-digest_check"))
+	    {
+		GlobalParams::digest_mode = true;
+		GlobalParams::digest_golden = arg_vet[++i];
+	    }
+	    else if (!strcmp(arg_vet[i], "-digest_trace"))
+	    {
+		GlobalParams::digest_mode = true;
+		GlobalParams::digest_trace_filename = arg_vet[++i];
+	    }
 	    else if (!strcmp(arg_vet[i], "-config") || !strcmp(arg_vet[i], "-power"))
 		// -config is managed from configure function
 		// i++ skips the configuration file name 
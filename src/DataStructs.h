@@ -12,6 +12,9 @@
 #define _DATASTRUCS_H__
 
 #include <systemc.h>
+#include <stdint.h>
+#include <cstring>
+#include <type_traits>
 #include "GlobalParams.h"
 
 // Coord -- XY coordinates type of the Tile inside the Mesh
@@ -25,13 +28,13 @@ class Coord {
 }};
 
 // FlitType -- Flit type enumeration
-enum FlitType {
+enum FlitType : uint8_t {
     FLIT_TYPE_HEAD, FLIT_TYPE_BODY, FLIT_TYPE_TAIL
 };
 
 // Payload -- Payload definition
 struct Payload {
-    sc_uint<32> data;	// Bus for the data to be exchanged
+    uint32_t data;	// Bus for the data to be exchanged
 
     inline bool operator ==(const Payload & payload) const {
 	return (payload.data == data);
@@ -46,6 +49,8 @@ struct Packet {
     int size;
     int flit_left;		// Number of remaining flits inside the packet
     bool use_low_voltage_path;
+    unsigned int packet_id;	// Entry of the PacketTable, set when the head flit is injected
+    long trace_id;		// Packet of a dependency trace, -1 otherwise
 
     // Constructors
     Packet() { }
@@ -62,6 +67,7 @@ struct Packet {
 	size = sz;
 	flit_left = sz;
 	use_low_voltage_path = false;
+	trace_id = -1;
     }
 };
 
@@ -74,61 +80,66 @@ struct RouteData {
     int vc_id;
 };
 
-struct ChannelStatus {
-    int free_slots;		// occupied buffer slots
-    bool available;		// 
-    inline bool operator ==(const ChannelStatus & bs) const {
-	return (free_slots == bs.free_slots && available == bs.available);
-    };
-};
-
 // NoP_data -- NoP Data definition
+// Status of the output channels of the sender, i.e. of the neighbors of
+// the sender: availability as a bitmask, one bit per direction
 struct NoP_data {
     int sender_id;
-    ChannelStatus channel_status_neighbor[DIRECTIONS];
+    unsigned int available_mask;	// bit d set if output d of the sender is not reserved
+    int free_slots[DIRECTIONS];		// free slots of the neighbor in direction d
+
+    inline bool isAvailable(const int d) const {
+	return (available_mask >> d) & 1;
+    };
 
     inline bool operator ==(const NoP_data & nop_data) const {
 	return (sender_id == nop_data.sender_id &&
-		nop_data.channel_status_neighbor[0] ==
-		channel_status_neighbor[0]
-		&& nop_data.channel_status_neighbor[1] ==
-		channel_status_neighbor[1]
-		&& nop_data.channel_status_neighbor[2] ==
-		channel_status_neighbor[2]
-		&& nop_data.channel_status_neighbor[3] ==
-		channel_status_neighbor[3]);
+		available_mask == nop_data.available_mask &&
+		memcmp(free_slots, nop_data.free_slots, sizeof(free_slots)) == 0);
     };
 };
 
+// TBufferFullStatus -- full VCs of an input port, bit vc set if full.
+// Kept up to date on push/pop, so that it is read, written and compared as
+// a single word
 struct TBufferFullStatus {
-    TBufferFullStatus()
-    {
-	for (int i=0;i<MAX_VIRTUAL_CHANNELS;i++)
-	    mask[i] = false;
-    };
+    TBufferFullStatus() : mask(0) {};
+
+    inline bool isFull(const int vc) const { return (mask >> vc) & 1; };
+    inline void setFull(const int vc) { mask |= 1u << vc; };
+    inline void clearFull(const int vc) { mask &= ~(1u << vc); };
+
     inline bool operator ==(const TBufferFullStatus & bfs) const {
-	for (int i=0;i<MAX_VIRTUAL_CHANNELS;i++)
-	    if (mask[i] != bfs.mask[i]) return false;
-	return true;
+	return mask == bfs.mask;
     };
-   
-    bool mask[MAX_VIRTUAL_CHANNELS];
+
+    uint32_t mask;
 };
 
+static_assert(MAX_VIRTUAL_CHANNELS <= 32, "TBufferFullStatus holds at most 32 VCs");
+
 // Flit -- Flit definition
+// Flits are copied through every buffer, link and wireless transaction,
+// hence the narrow fields: per-packet metadata (e.g. the generation
+// timestamp) is kept in the PacketTable and reached through packet_id.
+// The payload is only carried when compiled with -DFLIT_PAYLOAD
+#define FLIT_MAX_NODES       0x7FFF	// ids must fit hub_relay_node
+#define FLIT_MAX_PACKET_SIZE 0xFFFF
+
 struct Flit {
-    int src_id;
-    int dst_id;
-    int vc_id; // Virtual Channel
+    uint16_t src_id;
+    uint16_t dst_id;
+    uint16_t vc_id; // Virtual Channel
     FlitType flit_type;	// The flit type (FLIT_TYPE_HEAD, FLIT_TYPE_BODY, FLIT_TYPE_TAIL)
-    int sequence_no;		// The sequence number of the flit inside the packet
-    int sequence_length;
-    Payload payload;	// Optional payload
-    double timestamp;		// Unix timestamp at packet generation
-    int hop_no;			// Current number of hops from source to destination
     bool use_low_voltage_path;
-
-    int hub_relay_node;
+    uint16_t sequence_no;		// The sequence number of the flit inside the packet
+    uint16_t sequence_length;
+    uint16_t hop_no;			// Current number of hops from source to destination
+    int16_t hub_relay_node;
+    uint32_t packet_id;		// Index in the PacketTable
+#ifdef FLIT_PAYLOAD
+    Payload payload;	// Optional payload
+#endif
 
     inline bool operator ==(const Flit & flit) const {
 	return (flit.src_id == src_id && flit.dst_id == dst_id
@@ -136,11 +147,22 @@ struct Flit {
 		&& flit.vc_id == vc_id
 		&& flit.sequence_no == sequence_no
 		&& flit.sequence_length == sequence_length
-		&& flit.payload == payload && flit.timestamp == timestamp
+#ifdef FLIT_PAYLOAD
+		&& flit.payload == payload
+#endif
+		&& flit.packet_id == packet_id
 		&& flit.hop_no == hop_no
 		&& flit.use_low_voltage_path == use_low_voltage_path);
 }};
 
+// Flits are moved with plain copies and as raw bytes in TLM transactions
+static_assert(std::is_trivially_copyable<Flit>::value, "Flit must be trivially copyable");
+#ifdef FLIT_PAYLOAD
+static_assert(sizeof(Flit) <= 24, "Flit layout grew beyond 24 bytes");
+#else
+static_assert(sizeof(Flit) <= 20, "Flit layout grew beyond 20 bytes");
+#endif
+
 
 typedef struct 
 {
@@ -0,0 +1,53 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the functional network model
+ */
+
+#include "FunctionalNetwork.h"
+#include "GlobalParams.h"
+
+#include <cassert>
+
+FunctionalNetwork::FunctionalNetwork()
+{
+    packets = 0;
+    flits = 0;
+    delay_sum = 0.0;
+    n_endpoints = 0;
+    hop_cycles = ZERO_LOAD_HOP_CYCLES;
+}
+
+void FunctionalNetwork::build(const TopologyGraph & topology)
+{
+    n_endpoints = topology.n_endpoints;
+    hop_table.assign(n_endpoints * n_endpoints, 0);
+
+    // Walk the route of each pair on the path tables
+    for (int src = 0; src < n_endpoints; src++)
+	for (int dst = 0; dst < n_endpoints; dst++)
+	{
+	    int hops = 0;
+	    for (int node = src; node != dst; hops++)
+	    {
+		node = topology.neighbor(node, topology.nextPort(node, dst));
+		assert(node != NOT_VALID);
+	    }
+	    hop_table[src * n_endpoints + dst] = hops;
+	}
+}
+
+void FunctionalNetwork::calibrate(const double avg_delay, const double avg_size, const double avg_hops)
+{
+    // Too few packets, or only local ones, keep the previous fit
+    if (avg_hops <= 0 || avg_delay <= 0)
+	return;
+
+    double fit = (avg_delay - (avg_size - 1)) / avg_hops;
+    if (fit > 0)
+	hop_cycles = fit;
+}
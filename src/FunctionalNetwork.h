@@ -0,0 +1,68 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the functional network model
+ */
+
+#ifndef __NOXIMFUNCTIONALNETWORK_H__
+#define __NOXIMFUNCTIONALNETWORK_H__
+
+#include <vector>
+#include "Topology.h"
+
+using namespace std;
+
+// Zero-load cycles per hop: a flit received by a router is forwarded in
+// the next cycle
+#define ZERO_LOAD_HOP_CYCLES 2.0
+
+// Delivers packets without simulating them, as used by the fast-forward
+// phases of sampled runs. The latency of a packet is hop_cycles for each
+// hop of its route plus its serialisation, where hop_cycles is calibrated
+// on the delay measured by the last detailed window
+class FunctionalNetwork {
+
+  public:
+
+    FunctionalNetwork();
+
+    // Builds the hop counts between the endpoints of the topology
+    void build(const TopologyGraph & topology);
+
+    int hops(const int src, const int dst) const {
+	return hop_table[src * n_endpoints + dst];
+    }
+
+    double latency(const int src, const int dst, const int size) const {
+	return hop_cycles * hops(src, dst) + size - 1;
+    }
+
+    void deliver(const int src, const int dst, const int size) {
+	packets++;
+	flits += size;
+	delay_sum += latency(src, dst, size);
+    }
+
+    // Fits hop_cycles to the average delay of packets of the given
+    // average size and hop count
+    void calibrate(const double avg_delay, const double avg_size, const double avg_hops);
+
+    double getHopCycles() const { return hop_cycles; }
+
+    // Packets delivered so far
+    unsigned long packets;
+    unsigned long flits;
+    double delay_sum;
+
+  private:
+
+    int n_endpoints;
+    vector<unsigned short> hop_table;	// [src * n_endpoints + dst]
+    double hop_cycles;
+};
+
+#endif
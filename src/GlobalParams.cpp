@@ -20,11 +20,14 @@ int GlobalParams::mesh_dim_x;
 int GlobalParams::mesh_dim_y;
 
 int GlobalParams::n_delta_tiles;
+int GlobalParams::delta_radix;
+string GlobalParams::netlist_filename;
 
 double GlobalParams::r2r_link_length;
 double GlobalParams::r2h_link_length;
 int GlobalParams::buffer_depth;
 int GlobalParams::flit_size;
+bool GlobalParams::packet_mode;
 int GlobalParams::min_packet_size;
 int GlobalParams::max_packet_size;
 string GlobalParams::routing_algorithm;
@@ -36,6 +39,10 @@ double GlobalParams::locality;
 string GlobalParams::traffic_distribution;
 string GlobalParams::traffic_table_filename;
 string GlobalParams::traffic_hardcoded_filename;
+string GlobalParams::traffic_dependency_filename;
+int GlobalParams::dependency_window;
+int GlobalParams::source_queue_size;
+string GlobalParams::source_queue_policy;
 string GlobalParams::config_filename;
 string GlobalParams::power_config_filename;
 int GlobalParams::clock_period_ps;
@@ -52,6 +59,15 @@ bool GlobalParams::show_buffer_stats;
 bool GlobalParams::use_winoc;
 int GlobalParams::winoc_dst_hops;
 bool GlobalParams::use_powermanager;
+double GlobalParams::adaptive_precision;
+int GlobalParams::adaptive_batch_cycles;
+double GlobalParams::sweep_pir_min;
+double GlobalParams::sweep_pir_max;
+double GlobalParams::sweep_pir_step;
+int GlobalParams::sweep_bisections;
+int GlobalParams::sample_period;
+int GlobalParams::sample_warm_cycles;
+int GlobalParams::sample_measure_cycles;
 ChannelConfig GlobalParams::default_channel_configuration;
 map<int, ChannelConfig> GlobalParams::channel_configuration;
 HubConfig GlobalParams::default_hub_configuration;
@@ -60,4 +76,17 @@ map<int, int> GlobalParams::hub_for_tile;
 PowerConfig GlobalParams::power_configuration;
 // out of yaml configuration
 bool GlobalParams::ascii_monitor;
+bool GlobalParams::profile_mode;
+bool GlobalParams::analytical_mode;
+int GlobalParams::partitions;
+bool GlobalParams::partition_numa;
+string GlobalParams::injection_record_filename;
+bool GlobalParams::digest_mode;
+string GlobalParams::digest_golden;
+string GlobalParams::digest_trace_filename;
 int GlobalParams::channel_selection;
+int GlobalParams::n_delta_stages;
+int GlobalParams::n_delta_switches;
+TopologyType GlobalParams::topology_type;
+TrafficType GlobalParams::traffic_type;
+SourceQueuePolicy GlobalParams::source_queue_policy_type;
@@ -53,6 +53,15 @@ using namespace std;
 #define TOPOLOGY_BASELINE      "BASELINE"
 #define TOPOLOGY_BUTTERFLY     "BUTTERFLY"
 #define TOPOLOGY_OMEGA         "OMEGA"
+// Multi-stage network read from a netlist file
+#define TOPOLOGY_NETLIST       "NETLIST"
+
+// Topology family, resolved once from the topology string
+enum TopologyType {
+    TOPOLOGY_TYPE_MESH,
+    TOPOLOGY_TYPE_DELTA,	// BASELINE, BUTTERFLY and OMEGA
+    TOPOLOGY_TYPE_NETLIST
+};
 
 // Routing algorithms
 #define ROUTING_DYAD           "DYAD"
@@ -75,6 +84,45 @@ using namespace std;
 #define TRAFFIC_LOCAL	       "TRAFFIC_LOCAL"
 #define TRAFFIC_ULOCAL	       "TRAFFIC_ULOCAL"
 #define TRAFFIC_HARDCODED      "TRAFFIC_HARDCODED"
+#define TRAFFIC_DEPENDENCY     "TRAFFIC_DEPENDENCY"
+
+// Traffic distribution, resolved once from the traffic_distribution string
+enum TrafficType {
+    TRAFFIC_TYPE_RANDOM,
+    TRAFFIC_TYPE_TRANSPOSE1,
+    TRAFFIC_TYPE_TRANSPOSE2,
+    TRAFFIC_TYPE_BIT_REVERSAL,
+    TRAFFIC_TYPE_SHUFFLE,
+    TRAFFIC_TYPE_BUTTERFLY,
+    TRAFFIC_TYPE_LOCAL,
+    TRAFFIC_TYPE_ULOCAL,
+    TRAFFIC_TYPE_TABLE_BASED,
+    TRAFFIC_TYPE_HARDCODED,
+    TRAFFIC_TYPE_DEPENDENCY
+};
+
+// Policy applied when a PE generates a packet and its source queue is full
+#define SOURCE_QUEUE_STALL     "STALL"
+#define SOURCE_QUEUE_DROP      "DROP"
+#define SOURCE_QUEUE_RESAMPLE  "RESAMPLE"
+
+// Source queue policy, resolved once from the source_queue_policy string
+enum SourceQueuePolicy {
+    SOURCE_QUEUE_POLICY_STALL,		// generation is suspended while full
+    SOURCE_QUEUE_POLICY_DROP,		// the packet is discarded and counted
+    SOURCE_QUEUE_POLICY_RESAMPLE	// the packet is retried after a geometric delay
+};
+
+// A build can fix the routing algorithm, the selection strategy and the
+// traffic distribution, e.g. -DFIXED_ROUTING=XY -DFIXED_SELECTION=RANDOM
+// -DFIXED_TRAFFIC=RANDOM (names as in the configuration, without the
+// TRAFFIC_ prefix). The per-flit calls are then bound statically instead of
+// going through virtual functions, and checkConfiguration() rejects any
+// configuration that does not match the build
+#define NOXIM_CAT_(a, b)       a ## b
+#define NOXIM_CAT(a, b)        NOXIM_CAT_(a, b)
+#define NOXIM_STR_(x)          #x
+#define NOXIM_STR(x)           NOXIM_STR_(x)
 
 // Verbosity levels
 #define VERBOSE_OFF            "VERBOSE_OFF"
@@ -147,10 +195,13 @@ struct GlobalParams {
     static int mesh_dim_x;
     static int mesh_dim_y;
     static int n_delta_tiles;
+    static int delta_radix;
+    static string netlist_filename;
     static double r2r_link_length;
     static double r2h_link_length;
     static int buffer_depth;
     static int flit_size;
+    static bool packet_mode;	// packets move as a whole, see Router::txCycle()
     static int min_packet_size;
     static int max_packet_size;
     static string routing_algorithm;
@@ -162,6 +213,10 @@ struct GlobalParams {
     static string traffic_distribution;
     static string traffic_table_filename;
     static string traffic_hardcoded_filename;
+    static string traffic_dependency_filename;
+    static int dependency_window;
+    static int source_queue_size;	// packets, 0 for unbounded queues
+    static string source_queue_policy;
     static string config_filename;
     static string power_config_filename;
     static int clock_period_ps;
@@ -178,6 +233,15 @@ struct GlobalParams {
     static bool use_winoc;
     static int winoc_dst_hops;
     static bool use_powermanager;
+    static double adaptive_precision;
+    static int adaptive_batch_cycles;
+    static double sweep_pir_min;
+    static double sweep_pir_max;
+    static double sweep_pir_step;
+    static int sweep_bisections;
+    static int sample_period;
+    static int sample_warm_cycles;
+    static int sample_measure_cycles;
     static ChannelConfig default_channel_configuration;
     static map<int, ChannelConfig> channel_configuration;
     static HubConfig default_hub_configuration;
@@ -186,7 +250,20 @@ struct GlobalParams {
     static PowerConfig power_configuration;
     // out of yaml configuration
     static bool ascii_monitor;
+    static bool profile_mode;
+    static bool analytical_mode;
+    static int partitions;		// processes simulating the mesh, 0 = off
+    static bool partition_numa;
+    static string injection_record_filename;	// empty = no recording
+    static bool digest_mode;
+    static string digest_golden;	// expected digest, empty = no check
+    static string digest_trace_filename;	// empty = no per-node trace
     static int channel_selection;
+    static int n_delta_stages;		// derived from the delta topology
+    static int n_delta_switches;	// per stage
+    static TopologyType topology_type;	// derived from topology
+    static TrafficType traffic_type;	// derived from traffic_distribution
+    static SourceQueuePolicy source_queue_policy_type;	// derived from source_queue_policy
 };
 
 #endif
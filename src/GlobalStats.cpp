@@ -30,14 +30,14 @@ double GlobalStats::getAverageDelay()
 	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++) 
 	    {
-		unsigned int received_packets =
-		    noc->t[x][y]->r->stats.getReceivedPackets();
+		Stats & stats = noc->nodeStats(y * GlobalParams::mesh_dim_x + x);
+		unsigned int received_packets = stats.getReceivedPackets();
 
 		if (received_packets) 
 		{
 		    avg_delay +=
 			received_packets *
-			noc->t[x][y]->r->stats.getAverageDelay();
+			stats.getAverageDelay();
 		    total_packets += received_packets;
 		}
 	    }
@@ -71,11 +71,9 @@ double GlobalStats::getAverageDelay()
 double GlobalStats::getAverageDelay(const int src_id,
 					 const int dst_id)
 {
-    Tile *tile = noc->searchNode(dst_id);
+    assert(dst_id >= 0 && dst_id < (int) noc->topology.nodes.size());
 
-    assert(tile != NULL);
-
-    return tile->r->stats.getAverageDelay(src_id);
+    return noc->nodeStats(dst_id).getAverageDelay(src_id);
 }
 
 double GlobalStats::getMaxDelay()
@@ -114,13 +112,12 @@ double GlobalStats::getMaxDelay(const int node_id)
 {
     if (GlobalParams::topology == TOPOLOGY_MESH) 
     {
-	Coord coord = id2Coord(node_id);
+	Stats & stats = noc->nodeStats(node_id);
 
-	unsigned int received_packets =
-	    noc->t[coord.x][coord.y]->r->stats.getReceivedPackets();
+	unsigned int received_packets = stats.getReceivedPackets();
 
 	if (received_packets)
-	    return noc->t[coord.x][coord.y]->r->stats.getMaxDelay();
+	    return stats.getMaxDelay();
 	else
 	    return -1.0;
     }
@@ -138,11 +135,9 @@ double GlobalStats::getMaxDelay(const int node_id)
 
 double GlobalStats::getMaxDelay(const int src_id, const int dst_id)
 {
-    Tile *tile = noc->searchNode(dst_id);
-
-    assert(tile != NULL);
+    assert(dst_id >= 0 && dst_id < (int) noc->topology.nodes.size());
 
-    return tile->r->stats.getMaxDelay(src_id);
+    return noc->nodeStats(dst_id).getMaxDelay(src_id);
 }
 
 vector < vector < double > > GlobalStats::getMaxDelayMtx()
@@ -170,11 +165,9 @@ vector < vector < double > > GlobalStats::getMaxDelayMtx()
 
 double GlobalStats::getAverageThroughput(const int src_id, const int dst_id)
 {
-    Tile *tile = noc->searchNode(dst_id);
+    assert(dst_id >= 0 && dst_id < (int) noc->topology.nodes.size());
 
-    assert(tile != NULL);
-
-    return tile->r->stats.getAverageThroughput(src_id);
+    return noc->nodeStats(dst_id).getAverageThroughput(src_id);
 }
 
 /*
@@ -216,7 +209,7 @@ unsigned int GlobalStats::getReceivedPackets()
     {
     	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 		for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-	    n += noc->t[x][y]->r->stats.getReceivedPackets();
+	    n += noc->nodeStats(y * GlobalParams::mesh_dim_x + x).getReceivedPackets();
     }
     else // other delta topologies
     {
@@ -234,9 +227,9 @@ unsigned int GlobalStats::getReceivedFlits()
     {
 	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++) {
-		n += noc->t[x][y]->r->stats.getReceivedFlits();
+		n += noc->nodeStats(y * GlobalParams::mesh_dim_x + x).getReceivedFlits();
 #ifdef TESTING
-		drained_total += noc->t[x][y]->r->local_drained;
+		drained_total += noc->nodeDrained(y * GlobalParams::mesh_dim_x + x);
 #endif
 	    }
     }
@@ -282,7 +275,7 @@ double GlobalStats::getActiveThroughput()
 	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++) 
 	    {
-		rf = noc->t[x][y]->r->stats.getReceivedFlits();
+		rf = noc->nodeStats(y * GlobalParams::mesh_dim_x + x).getReceivedFlits();
 
 		if (rf != 0)
 		    n++;
@@ -319,7 +312,7 @@ vector < vector < unsigned long > > GlobalStats::getRoutedFlitsMtx()
 
     for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 	for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-	    mtx[y][x] = noc->t[x][y]->r->getRoutedFlits();
+	    mtx[y][x] = noc->nodeRoutedFlits(y * GlobalParams::mesh_dim_x + x);
 
 
     return mtx;
@@ -353,15 +346,13 @@ double GlobalStats::getDynamicPower()
     {
 	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-		power += noc->t[x][y]->r->power.getDynamicPower();
+		power += noc->nodePower(y * GlobalParams::mesh_dim_x + x).getDynamicPower();
     }
     else // other delta topologies
     {
-	int stg = log2(GlobalParams::n_delta_tiles);
-	int sw = GlobalParams::n_delta_tiles/2; //sw: switch number in each stage
 	// Dimensions of the delta switch block network
-	int dimX = stg;
-	int dimY = sw;
+	int dimX = GlobalParams::n_delta_stages;
+	int dimY = GlobalParams::n_delta_switches;
 
 	// power for delta topologies cores
 	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
@@ -396,15 +387,13 @@ double GlobalStats::getStaticPower()
     {
     	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 		for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-	    power += noc->t[x][y]->r->power.getStaticPower();
+	    power += noc->nodePower(y * GlobalParams::mesh_dim_x + x).getStaticPower();
     }
     else // other delta topologies
     {
-	int stg = log2(GlobalParams::n_delta_tiles);
-	int sw = GlobalParams::n_delta_tiles/2; //sw: switch number in each stage
 	// Dimensions of the delta switch block network
-	int dimX = stg;
-	int dimY = sw;
+	int dimX = GlobalParams::n_delta_stages;
+	int dimY = GlobalParams::n_delta_switches;
 	// power for delta topologies switches 
 	for (int y = 0; y < dimY; y++)
 	    for (int x = 0; x < dimX; x++)
@@ -440,7 +429,7 @@ void GlobalStats::showStats(std::ostream & out, bool detailed)
 
 	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-		noc->t[x][y]->r->stats.showStats(y * GlobalParams:: mesh_dim_x + x, out, true);
+		noc->nodeStats(y * GlobalParams::mesh_dim_x + x).showStats(y * GlobalParams:: mesh_dim_x + x, out, true);
 	out << "];" << endl;
 
 	// show MaxDelay matrix
@@ -492,7 +481,7 @@ void GlobalStats::showStats(std::ostream & out, bool detailed)
     {
 	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-		out << "PE["<<x << "," << y<< "]" << noc->t[x][y]->pe->getQueueSize()<< ",";
+		out << "PE["<<x << "," << y<< "]" << noc->nodeSourceQueue(y * GlobalParams::mesh_dim_x + x).size<< ",";
     }
     else // other delta topologies
     {
@@ -518,6 +507,12 @@ void GlobalStats::showStats(std::ostream & out, bool detailed)
     out << "% \tDynamic energy (J): " << getDynamicPower() << endl;
     out << "% \tStatic energy (J): " << getStaticPower() << endl;
 
+    if (GlobalParams::traffic_type == TRAFFIC_TYPE_DEPENDENCY)
+	noc->gdtable.showStats(out);
+
+    if (GlobalParams::source_queue_size > 0)
+	showSourceQueueStats(out);
+
     if (GlobalParams::show_buffer_stats)
       showBufferStats(out);
 
@@ -554,9 +549,9 @@ void GlobalStats::showPowerManagerStats(std::ostream & out)
 	out << "\t" << hub_id << "\t" << std::fixed << (double)h->total_ttxoff_cycles/total_cycles << "\t";
 
 	int s = 0;
-	for (map<int,int>::iterator i = h->abtxoff_cycles.begin(); i!=h->abtxoff_cycles.end();i++) s+=i->second;
+	for (unsigned int i = 0; i < h->txChannels.size(); i++) s+=h->abtxoff_cycles[i];
 
-	out << (double)s/h->abtxoff_cycles.size()/total_cycles << endl;
+	out << (double)s/h->txChannels.size()/total_cycles << endl;
     }
 
     out << "];" << endl;
@@ -585,18 +580,16 @@ void GlobalStats::showPowerManagerStats(std::ostream & out)
 	out << "\t" << hub_id << "\t" << std::fixed << (double)h->total_sleep_cycles/total_cycles << "\t";
 
 	int s = 0;
-	for (map<int,int>::iterator i = h->buffer_rx_sleep_cycles.begin();
-		i!=h->buffer_rx_sleep_cycles.end();i++)
-	    s+=i->second;
+	for (unsigned int i = 0; i < h->rxChannels.size(); i++)
+	    s+=h->buffer_rx_sleep_cycles[i];
 
-	out << (double)s/h->buffer_rx_sleep_cycles.size()/total_cycles << "\t";
+	out << (double)s/h->rxChannels.size()/total_cycles << "\t";
 
 	s = 0;
-	for (map<int,int>::iterator i = h->buffer_to_tile_poweroff_cycles.begin();
-		i!=h->buffer_to_tile_poweroff_cycles.end();i++)
+	for (int i = 0; i < h->num_ports; i++)
 	{
-	    double bttoff_fraction = i->second/(double)total_cycles;
-	    s+=i->second;
+	    double bttoff_fraction = h->buffer_to_tile_poweroff_cycles[i]/(double)total_cycles;
+	    s+=h->buffer_to_tile_poweroff_cycles[i];
 	    if (bttoff_fraction<0.25)
 		bttoff_str+=" ";
 	    else if (bttoff_fraction<0.5)
@@ -610,7 +603,7 @@ void GlobalStats::showPowerManagerStats(std::ostream & out)
 	    
 
 	}
-	out << (double)s/h->buffer_to_tile_poweroff_cycles.size()/total_cycles << "\t" << bttoff_str << endl;
+	out << (double)s/h->num_ports/total_cycles << "\t" << bttoff_str << endl;
     }
 
     out << "];" << endl;
@@ -631,8 +624,9 @@ void GlobalStats::showPowerBreakDown(std::ostream & out)
 	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
 	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
 	    {
-		updatePowerBreakDown(power_dynamic, noc->t[x][y]->r->power.getDynamicPowerBreakDown());
-		updatePowerBreakDown(power_static, noc->t[x][y]->r->power.getStaticPowerBreakDown());
+		Power & power = noc->nodePower(y * GlobalParams::mesh_dim_x + x);
+		updatePowerBreakDown(power_dynamic, power.getDynamicPowerBreakDown());
+		updatePowerBreakDown(power_static, power.getStaticPowerBreakDown());
 	    }
     }
     else // other delta topologies
@@ -667,6 +661,42 @@ void GlobalStats::showPowerBreakDown(std::ostream & out)
 
 
 
+void GlobalStats::showSourceQueueStats(std::ostream & out)
+{
+    // Mesh tiles and delta cores are the endpoints
+    vector<SourceQueueSummary> pes;
+    for (int id = 0; id < noc->topology.n_endpoints; id++)
+	pes.push_back(noc->nodeSourceQueue(id));
+
+    double occupancy = 0.0;
+    unsigned int max_occupancy = 0;
+    unsigned long blocked_cycles = 0;
+    unsigned long dropped_packets = 0;
+    unsigned long dropped_flits = 0;
+    for (unsigned int i = 0; i < pes.size(); i++)
+    {
+	occupancy += pes[i].average_size;
+	max_occupancy = max(max_occupancy, pes[i].max_size);
+	blocked_cycles += pes[i].blocked_cycles;
+	dropped_packets += pes[i].dropped_packets;
+	dropped_flits += pes[i].dropped_flits;
+    }
+
+    out << "% Source queue size (packets): " << GlobalParams::source_queue_size
+	<< ", policy " << GlobalParams::source_queue_policy << endl;
+    out << "% Average source queue occupancy (packets): " << occupancy / pes.size() << endl;
+    out << "% Max source queue occupancy (packets): " << max_occupancy << endl;
+    out << "% Average blocked cycles per PE: " << (double) blocked_cycles / pes.size() << endl;
+    if (GlobalParams::source_queue_policy_type == SOURCE_QUEUE_POLICY_DROP)
+	out << "% Dropped packets: " << dropped_packets << " (" << dropped_flits << " flits)" << endl;
+
+    int saturated = noc->getSaturatedSources();
+    if (saturated > 0)
+	out << "% Warning: " << saturated << " of " << pes.size()
+	    << " source queues saturated (full and not drained for "
+	    << SOURCE_QUEUE_SATURATION_CYCLES << " cycles)" << endl;
+}
+
 void GlobalStats::showBufferStats(std::ostream & out)
 {
   out << "Router id\tBuffer N\t\tBuffer E\t\tBuffer S\t\tBuffer W\t\tBuffer L" << endl;
@@ -83,6 +83,9 @@ class GlobalStats {
 
     void showBufferStats(std::ostream & out);
 
+    // Occupancy, blocked cycles and losses of the bounded source queues
+    void showSourceQueueStats(std::ostream & out);
+
 
     void showPowerBreakDown(std::ostream & out);
 
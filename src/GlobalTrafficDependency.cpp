@@ -0,0 +1,226 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the dependency-driven traffic trace
+ */
+
+#include "GlobalTrafficDependency.h"
+#include "GlobalParams.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <cassert>
+#include <algorithm>
+
+GlobalTrafficDependency::GlobalTrafficDependency()
+{
+    eof = true;
+    n_cores = 0;
+    start = 0;
+    base = 0;
+    read_packets = 0;
+    delivered_packets = 0;
+    late_dependencies = 0;
+    total_latency = 0;
+    last_delivery = -1;
+    critical_packets = 0;
+    critical_compute = 0;
+    critical_latency = 0;
+}
+
+bool GlobalTrafficDependency::load(const char *_fname)
+{
+    fname = _fname;
+    fin.open(_fname, ios::in);
+    if (!fin)
+	return false;
+
+    if (GlobalParams::topology_type == TOPOLOGY_TYPE_MESH)
+	n_cores = GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y;
+    else
+	n_cores = GlobalParams::n_delta_tiles;
+
+    ready.resize(n_cores);
+    start = GlobalParams::reset_time;
+    eof = false;
+    refill(start);
+
+    return true;
+}
+
+void GlobalTrafficDependency::refill(const double now)
+{
+    while (!eof && (long) window.size() < GlobalParams::dependency_window)
+	eof = !readPacket(now);
+}
+
+bool GlobalTrafficDependency::readPacket(const double now)
+{
+    string line;
+
+    while (getline(fin, line))
+    {
+	if (line.empty() || line[0] == '%' || line[0] == '#')
+	    continue;
+
+	const char *s = line.c_str();
+	char *end;
+	long id = strtol(s, &end, 10);
+	if (end == s)
+	    continue;	// blank line
+
+	DependencyPacket p;
+	p.src = strtol(s = end, &end, 10);
+	p.dst = strtol(s = end, &end, 10);
+	p.size = strtol(s = end, &end, 10);
+	p.delay = strtol(s = end, &end, 10);
+
+	if (end == s || id != base + (long) window.size() ||
+	    p.src < 0 || p.src >= n_cores || p.dst < 0 || p.dst >= n_cores ||
+	    p.src == p.dst || p.size < 0 || p.delay < 0)
+	{
+	    cerr << "Error: invalid packet in dependency trace " << fname << ": " << line << endl;
+	    exit(1);
+	}
+
+	p.pending = 0;
+	p.last_dependency = start;
+	p.ready = -1;
+	p.delivered = -1;
+	p.crit_packets = 0;
+	p.crit_compute = 0;
+	p.crit_latency = 0;
+
+	for (s = end; ; s = end)
+	{
+	    long dep = strtol(s, &end, 10);
+	    if (end == s)
+		break;
+
+	    if (dep < 0 || dep >= id)
+	    {
+		cerr << "Error: packet " << id << " of dependency trace " << fname << " depends on a later packet" << endl;
+		exit(1);
+	    }
+
+	    if (dep < base)
+	    {
+		// delivered before now, but its cycle has been dropped
+		late_dependencies++;
+		p.last_dependency = max(p.last_dependency, now);
+	    }
+	    else if (window[dep - base].delivered < 0)
+	    {
+		p.pending++;
+		window[dep - base].dependents.push_back(id);
+	    }
+	    else
+		satisfy(p, window[dep - base]);
+	}
+
+	window.push_back(p);
+	read_packets++;
+
+	if (p.pending == 0)
+	    makeReady(id, window.back());
+
+	return true;
+    }
+
+    return false;
+}
+
+void GlobalTrafficDependency::satisfy(DependencyPacket & p, const DependencyPacket & dep)
+{
+    // The chain goes through the dependency delivered last
+    if (dep.delivered >= p.last_dependency)
+    {
+	p.last_dependency = dep.delivered;
+	p.crit_packets = dep.crit_packets;
+	p.crit_compute = dep.crit_compute;
+	p.crit_latency = dep.crit_latency;
+    }
+}
+
+void GlobalTrafficDependency::makeReady(const long id, DependencyPacket & p)
+{
+    p.ready = p.last_dependency + p.delay;
+    p.crit_compute += p.delay;
+    ready[p.src].push(ReadyEntry(p.ready, id));
+}
+
+bool GlobalTrafficDependency::nextReady(const int src, const double now, long & id, int & dst, int & size)
+{
+    if (ready[src].empty() || ready[src].top().first > now)
+	return false;
+
+    id = ready[src].top().second;
+    ready[src].pop();
+
+    const DependencyPacket & p = window[id - base];
+    dst = p.dst;
+    size = p.size;
+
+    return true;
+}
+
+void GlobalTrafficDependency::delivered(const long id, const double now)
+{
+    assert(id >= base && id < base + (long) window.size());
+
+    DependencyPacket & p = window[id - base];
+    p.delivered = now;
+    p.crit_packets++;
+    p.crit_latency += now - p.ready;
+
+    delivered_packets++;
+    total_latency += now - p.ready;
+    if (now >= last_delivery)
+    {
+	last_delivery = now;
+	critical_packets = p.crit_packets;
+	critical_compute = p.crit_compute;
+	critical_latency = p.crit_latency;
+    }
+
+    for (unsigned int i = 0; i < p.dependents.size(); i++)
+    {
+	DependencyPacket & d = window[p.dependents[i] - base];
+	satisfy(d, p);
+	if (--d.pending == 0)
+	    makeReady(p.dependents[i], d);
+    }
+    p.dependents.clear();
+
+    // Delivered packets leave the window in order
+    while (!window.empty() && window.front().delivered >= 0)
+    {
+	window.pop_front();
+	base++;
+    }
+
+    refill(now);
+}
+
+void GlobalTrafficDependency::showStats(std::ostream & out) const
+{
+    out << "% Dependency trace delivered packets: " << delivered_packets << " of " << read_packets << " read" << endl;
+    if (completed())
+	out << "% Application completion time (cycles): " << last_delivery - start << endl;
+    else
+	out << "% Application completion time (cycles): not completed" << endl;
+
+    if (delivered_packets > 0)
+	out << "% Average trace packet latency, ready to delivered (cycles): " << total_latency / delivered_packets << endl;
+
+    out << "% Critical path packets: " << critical_packets << endl;
+    out << "% Critical path compute delay (cycles): " << critical_compute << endl;
+    out << "% Critical path network latency (cycles): " << critical_latency << endl;
+
+    if (late_dependencies > 0)
+	out << "% Dependencies older than the window (taken as satisfied): " << late_dependencies << endl;
+}
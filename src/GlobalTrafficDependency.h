@@ -0,0 +1,109 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the dependency-driven traffic trace
+ */
+
+#ifndef __NOXIMGLOBALTRAFFICDEPENDENCY_H__
+#define __NOXIMGLOBALTRAFFICDEPENDENCY_H__
+
+#include <fstream>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <functional>
+
+using namespace std;
+
+// Closed-loop traces, in the style of Netrace. Each line describes a packet:
+//
+//   id src dst size delay [dep ...]
+//
+// ids are consecutive from 0, size is in flits (0 for a random size) and
+// the deps are ids of earlier packets. A packet can be injected delay
+// cycles after its last dependency has been delivered (after the end of
+// the reset if it has none), so that a slower network delays the rest of
+// the application. Lines starting with % or # are comments.
+//
+// Only a window of packets is kept in memory: the trace is read as the
+// oldest packets are delivered. Dependencies older than the window are
+// taken as satisfied when the dependent packet is read.
+
+struct DependencyPacket {
+    int src;
+    int dst;
+    int size;
+    int delay;
+    int pending;		// dependencies not delivered yet
+    double last_dependency;	// delivery of the last dependency
+    double ready;		// cycle from which it can be injected
+    double delivered;		// -1 until the tail flit is delivered
+    vector<long> dependents;	// later packets waiting for this one
+
+    // Critical path ending with this packet: packets, compute delays and
+    // latencies (ready to delivered) along the chain of last dependencies
+    int crit_packets;
+    double crit_compute;
+    double crit_latency;
+};
+
+class GlobalTrafficDependency {
+
+  public:
+
+    GlobalTrafficDependency();
+
+    // Opens the trace and reads the first window. Returns true if ok,
+    // false otherwise
+    bool load(const char *fname);
+
+    // Takes the next packet of src that can be injected at cycle now.
+    // Returns false if there is none
+    bool nextReady(const int src, const double now, long & id, int & dst, int & size);
+
+    // The tail flit of packet id has been delivered at cycle now
+    void delivered(const long id, const double now);
+
+    // All the packets of the trace have been delivered
+    bool completed() const { return eof && window.empty(); }
+
+    void showStats(std::ostream & out) const;
+
+  private:
+
+    ifstream fin;
+    string fname;
+    bool eof;
+    int n_cores;
+    double start;		// first cycle out of reset
+
+    deque<DependencyPacket> window;	// packets base, base + 1, ...
+    long base;
+
+    // Ready packets of each source, by (ready cycle, id)
+    typedef pair<double, long> ReadyEntry;
+    vector<priority_queue<ReadyEntry, vector<ReadyEntry>, greater<ReadyEntry> > > ready;
+
+    // Statistics
+    long read_packets;
+    long delivered_packets;
+    long late_dependencies;	// dependencies read after their eviction
+    double total_latency;
+    double last_delivery;
+    // Critical path of the last delivered packet
+    int critical_packets;
+    double critical_compute;
+    double critical_latency;
+
+    void refill(const double now);
+    bool readPacket(const double now);
+    void satisfy(DependencyPacket & p, const DependencyPacket & dep);
+    void makeReady(const long id, DependencyPacket & p);
+};
+
+#endif
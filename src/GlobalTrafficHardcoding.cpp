@@ -9,73 +9,215 @@
  */
 
 #include "GlobalTrafficHardcoding.h"
+#include "DataStructs.h"
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace std;
 
 GlobalTrafficHardcoding::GlobalTrafficHardcoding()
 {
+  n_cycles = 0;
+  n_sources = 0;
+  first = NULL;
+  entries = NULL;
+  shapes = NULL;
+  mapping = NULL;
+  mapping_size = 0;
+}
+
+GlobalTrafficHardcoding::~GlobalTrafficHardcoding()
+{
+  unload();
+}
+
+void GlobalTrafficHardcoding::unload()
+{
+  if (mapping != NULL)
+    munmap(mapping, mapping_size);
+  mapping = NULL;
+  mapping_size = 0;
+
+  text_first.clear();
+  text_entries.clear();
+  n_cycles = 0;
+  n_sources = 0;
+  first = NULL;
+  entries = NULL;
+  shapes = NULL;
 }
 
 bool GlobalTrafficHardcoding::load(const char *fname)
+{
+  unload();
+
+  // Binary traces are recognized by their magic
+  char magic[sizeof(HARDCODED_TRACE_MAGIC) - 1];
+  FILE *f = fopen(fname, "rb");
+  if (f == NULL)
+    return false;
+  bool binary = (fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+                 memcmp(magic, HARDCODED_TRACE_MAGIC, sizeof(magic)) == 0);
+  fclose(f);
+
+  return binary ? loadBinary(fname) : loadText(fname);
+}
+
+bool GlobalTrafficHardcoding::loadText(const char *fname)
 {
   // Open file
   ifstream fin(fname, ios::in);
   if (!fin)
     return false;
 
-  // Initialize variables
-  traffic_list.clear();
-  
-  vector<HardcodedTrafficEntry> current_cycle_traffic;
-  
-  // Cycle reading file
-  while (!fin.eof()) {
-    char line[512];
-    fin.getline(line, sizeof(line) - 1);
-
-    if (line[0] != '\0') {
-      // Skip comment lines
-      if (line[0] != '%' && line[0] != '#') {
-        int src, dst;
-        
-        int params = sscanf(line, "%d %d", &src, &dst);
-        
-        if (params == 2) {
-          // Check for end-of-cycle marker
-          if (src == -1) {
-            // End of current cycle - add the accumulated traffic to the list
-            traffic_list.push_back(current_cycle_traffic);
-            current_cycle_traffic.clear();
-          } else {
-            // Valid traffic entry - add to current cycle
-            HardcodedTrafficEntry entry;
-            entry.src = src;
-            entry.dst = dst;
-            current_cycle_traffic.push_back(entry);
-          }
-        } else if (params == 1 && src == -1) {
-          // Single -1 on a line (end of cycle or dead cycle)
-          traffic_list.push_back(current_cycle_traffic);
-          current_cycle_traffic.clear();
-        }
-      }
+  // Packets in file order, then bucketed by source
+  vector<int> sources;
+  vector<HardcodedTraceEntry> packets;
+  size_t pending = 0;	// packets of the current, unterminated cycle
+
+  string line;
+  while (getline(fin, line)) {
+    int src, dst;
+
+    switch (parseHardcodedLine(line.c_str(), src, dst)) {
+    case HARDCODED_LINE_PACKET: {
+      HardcodedTraceEntry entry;
+      entry.cycle = n_cycles;
+      entry.dst = dst;
+      sources.push_back(src);
+      packets.push_back(entry);
+      if ((uint32_t) src >= n_sources)
+        n_sources = src + 1;
+      pending++;
+      break;
+    }
+    case HARDCODED_LINE_END_CYCLE:
+      n_cycles++;
+      pending = 0;
+      break;
     }
   }
-  
-  // If there's remaining traffic in current_cycle_traffic, add it
-  if (!current_cycle_traffic.empty()) {
-    traffic_list.push_back(current_cycle_traffic);
+
+  // If there's remaining traffic in the current cycle, add it
+  if (pending > 0)
+    n_cycles++;
+
+  // Counting sort by source keeps the file order within each source
+  text_first.assign(n_sources + 1, 0);
+  for (size_t i = 0; i < sources.size(); i++)
+    text_first[sources[i] + 1]++;
+  for (uint32_t s = 0; s < n_sources; s++)
+    text_first[s + 1] += text_first[s];
+
+  vector<uint64_t> next(text_first.begin(), text_first.end() - 1);
+  text_entries.resize(packets.size());
+  for (size_t i = 0; i < packets.size(); i++)
+    text_entries[next[sources[i]]++] = packets[i];
+
+  first = &text_first[0];
+  entries = text_entries.empty() ? NULL : &text_entries[0];
+
+  return true;
+}
+
+bool GlobalTrafficHardcoding::loadBinary(const char *fname)
+{
+  int fd = open(fname, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(HardcodedTraceHeader)) {
+    cerr << "Error: truncated hardcoded trace " << fname << endl;
+    close(fd);
+    return false;
+  }
+
+  mapping_size = st.st_size;
+  mapping = mmap(NULL, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    mapping = NULL;
+    cerr << "Error: cannot map hardcoded trace " << fname << endl;
+    return false;
+  }
+
+  // PEs read their buckets forward: pages already consumed can be dropped
+  madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+
+  const HardcodedTraceHeader *header = (const HardcodedTraceHeader *) mapping;
+  n_cycles = header->num_cycles;
+  n_sources = header->num_sources;
+  first = (const uint64_t *) (header + 1);
+  entries = (const HardcodedTraceEntry *) (first + n_sources + 1);
+
+  if ((header->flags & ~HARDCODED_TRACE_SHAPED) != 0) {
+    cerr << "Error: unsupported flags in hardcoded trace " << fname << endl;
+    unload();
+    return false;
+  }
+
+  size_t index_size = sizeof(HardcodedTraceHeader) + (n_sources + 1) * sizeof(uint64_t);
+  size_t entry_size = sizeof(HardcodedTraceEntry);
+  if (header->flags & HARDCODED_TRACE_SHAPED)
+    entry_size += sizeof(HardcodedTraceShape);
+
+  if (mapping_size < index_size ||
+      mapping_size < index_size + first[n_sources] * entry_size ||
+      first[0] != 0) {
+    cerr << "Error: truncated or corrupted hardcoded trace " << fname << endl;
+    unload();
+    return false;
+  }
+
+  if (header->flags & HARDCODED_TRACE_SHAPED) {
+    shapes = (const HardcodedTraceShape *) (entries + first[n_sources]);
+
+    // Packets the PEs could not inject: a single flit would never release
+    // its reservations
+    for (uint64_t i = 0; i < first[n_sources]; i++)
+      if (shapes[i].size < 2 || shapes[i].size > FLIT_MAX_PACKET_SIZE ||
+          shapes[i].vc >= GlobalParams::n_virtual_channels) {
+        cerr << "Error: packet " << i << " of hardcoded trace " << fname
+             << " has an invalid size or virtual channel" << endl;
+        unload();
+        return false;
+      }
   }
 
+  for (uint32_t s = 0; s < n_sources; s++)
+    if (first[s] > first[s + 1]) {
+      cerr << "Error: corrupted index in hardcoded trace " << fname << endl;
+      unload();
+      return false;
+    }
+
   return true;
 }
 
-vector < HardcodedTrafficEntry > const& GlobalTrafficHardcoding::traffic_at_cycle(int cycle) const {
-  return traffic_list[cycle];
+const HardcodedTraceEntry * GlobalTrafficHardcoding::trafficOf(int src, size_t & count) const {
+  if (src < 0 || (uint32_t) src >= n_sources) {
+    count = 0;
+    return NULL;
+  }
+
+  count = first[src + 1] - first[src];
+  return entries + first[src];
+}
+
+const HardcodedTraceShape * GlobalTrafficHardcoding::shapesOf(int src) const {
+  if (shapes == NULL || src < 0 || (uint32_t) src >= n_sources)
+    return NULL;
+
+  return shapes + first[src];
 }
 
 size_t GlobalTrafficHardcoding::num_cycles() const {
-  return traffic_list.size();
+  return n_cycles;
 }
@@ -14,34 +14,49 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <vector>
-#include "DataStructs.h"
+#include "HardcodedTrace.h"
 
 using namespace std;
 
-// Structure used to store information into the table
-struct HardcodedTrafficEntry {
-  int src;			// ID of the source node (PE)
-  int dst;			// ID of the destination node (PE)
-};
-
 class GlobalTrafficHardcoding {
 
   public:
 
     GlobalTrafficHardcoding();
+    ~GlobalTrafficHardcoding();
 
-    // Load traffic table from file. Returns true if ok, false otherwise
+    // Load a text or binary trace (see HardcodedTrace.h). Returns true
+    // if ok, false otherwise
     bool load(const char *fname);
 
-    vector < HardcodedTrafficEntry > const& traffic_at_cycle(int cycle) const;
+    // Packets injected by src, sorted by cycle. count is 0 for sources
+    // without packets
+    const HardcodedTraceEntry * trafficOf(int src, size_t & count) const;
+
+    // Shapes of the packets returned by trafficOf, NULL if the trace has
+    // none
+    const HardcodedTraceShape * shapesOf(int src) const;
 
     size_t num_cycles() const;
 
   private:
 
-    // Outer vector: Which cycle the traffic occurs at
-    // Inner vector: Attempted packets at given cycle
-    vector < vector < HardcodedTrafficEntry > > traffic_list;
+    bool loadText(const char *fname);
+    bool loadBinary(const char *fname);
+    void unload();
+
+    size_t n_cycles;
+    uint32_t n_sources;
+    const uint64_t * first;
+    const HardcodedTraceEntry * entries;
+    const HardcodedTraceShape * shapes;
+
+    // Text traces are bucketed by source in memory, while binary traces
+    // are mapped, so that only the pages being consumed are resident
+    vector<uint64_t> text_first;
+    vector<HardcodedTraceEntry> text_entries;
+    void * mapping;
+    size_t mapping_size;
 };
 
 #endif
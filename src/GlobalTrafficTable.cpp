@@ -10,6 +10,8 @@
 
 #include "GlobalTrafficTable.h"
 
+#include <algorithm>
+
 GlobalTrafficTable::GlobalTrafficTable()
 {
 }
@@ -117,6 +119,30 @@ double GlobalTrafficTable::getCumulativePirPor(const int src_id,
   return cpirnpor;
 }
 
+double GlobalTrafficTable::getAverageRates(const int src_id,
+					    vector < pair < int, double > > &dst_rate)
+{
+  double total = 0.0;
+
+  dst_rate.clear();
+
+  for (unsigned int i = 0; i < traffic_table.size(); i++) {
+    Communication comm = traffic_table[i];
+    if (comm.src == src_id) {
+      // Active in the cycles t_on < r < t_off of each period
+      int active = min(comm.t_off, comm.t_period) - max(comm.t_on + 1, 0);
+      if (active <= 0 || (1 + comm.pir - comm.por) <= 0)
+	continue;
+
+      double rate = comm.pir / (1 + comm.pir - comm.por) * active / comm.t_period;
+      dst_rate.push_back(pair < int, double >(comm.dst, rate));
+      total += rate;
+    }
+  }
+
+  return total;
+}
+
 int GlobalTrafficTable::occurrencesAsSource(const int src_id)
 {
   int count = 0;
@@ -46,6 +46,12 @@ class GlobalTrafficTable {
 			       const bool pir_not_por,
 			       vector < pair < int, double > > &dst_prob);
 
+    // Returns the long-run packet injection rate of source src_id along
+    // with a vector of pairs of destination and rate towards it, averaged
+    // over the activity period of each communication
+    double getAverageRates(const int src_id,
+			   vector < pair < int, double > > &dst_rate);
+
     // Returns the number of occurrences of soruce src_id in the traffic
     // table
     int occurrencesAsSource(const int src_id);
@@ -0,0 +1,80 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the formats of the hardcoded traffic traces
+ */
+
+#ifndef __NOXIMHARDCODEDTRACE_H__
+#define __NOXIMHARDCODEDTRACE_H__
+
+#include <stdint.h>
+#include <cstdio>
+
+// Text traces list the packets injected at each cycle as "src dst" lines.
+// A line starting with -1 ends the current cycle (an empty cycle is a
+// single -1 line), and lines starting with % or # are comments.
+//
+// Binary traces, in native byte order, hold the same packets bucketed by
+// source, so that each PE reads its own packets only:
+//
+//   HardcodedTraceHeader
+//   uint64_t first[num_sources + 1]	packets of source s are the entries
+//					first[s] .. first[s + 1] - 1
+//   HardcodedTraceEntry entries[]	by cycle within each source
+//   HardcodedTraceShape shapes[]	only with HARDCODED_TRACE_SHAPED,
+//					one per entry
+//
+// other/hardcoded2bin converts text traces to binary ones. Schedules
+// recorded with -record_injection are binary traces with shapes, so that
+// replaying them draws no random numbers at all.
+
+#define HARDCODED_TRACE_MAGIC "NOXIMHT1"
+
+struct HardcodedTraceHeader {
+    char magic[8];		// HARDCODED_TRACE_MAGIC, not terminated
+    uint64_t num_cycles;	// cycles of the trace, empty ones included
+    uint32_t num_sources;	// highest source id + 1
+    uint32_t flags;		// HARDCODED_TRACE_*, 0 for plain traces
+};
+
+// Flags of the header
+#define HARDCODED_TRACE_SHAPED 1
+
+struct HardcodedTraceEntry {
+    uint32_t cycle;
+    int32_t dst;
+};
+
+// Size and virtual channel of a packet, drawn at random when missing
+struct HardcodedTraceShape {
+    uint16_t size;		// flits
+    uint16_t vc;
+};
+
+// Kinds of line of a text trace
+#define HARDCODED_LINE_SKIP      0
+#define HARDCODED_LINE_PACKET    1
+#define HARDCODED_LINE_END_CYCLE 2
+
+inline int parseHardcodedLine(const char *line, int & src, int & dst)
+{
+    if (line[0] == '\0' || line[0] == '%' || line[0] == '#')
+	return HARDCODED_LINE_SKIP;
+
+    int params = sscanf(line, "%d %d", &src, &dst);
+
+    if (params >= 1 && src == -1)
+	return HARDCODED_LINE_END_CYCLE;
+
+    // packets of negative sources are never injected
+    if (params == 2 && src >= 0)
+	return HARDCODED_LINE_PACKET;
+
+    return HARDCODED_LINE_SKIP;
+}
+
+#endif
@@ -9,31 +9,30 @@
  * to forward configuration to every sub-block
  */
 #include "Hub.h"
+#include "Profiler.h"
 
 int Hub::tile2Port(int id)
 {
-	// TODO: check all [..] map access to replace with at()
-	return tile2port_mapping.at(id);
+	assert(id >= 0 && id < (int)tile2port_mapping.size() && tile2port_mapping[id] != NOT_VALID);
+	return tile2port_mapping[id];
 }
 
 int Hub::route(Flit& f)
 {
-	// check if it is a local delivery
-	for (vector<int>::size_type i=0; i< GlobalParams::hub_configuration[local_id].attachedNodes.size();i++)
+	// check if it is a local delivery to a destination which is
+	// connected to the Hub...
+	if (f.dst_id < tile2port_mapping.size() && tile2port_mapping[f.dst_id] != NOT_VALID)
+		return tile2port_mapping[f.dst_id];
+
+	// ...or to a relay which is locally connected to the Hub
+	if (f.hub_relay_node != NOT_VALID &&
+		f.hub_relay_node < (int)tile2port_mapping.size() &&
+		tile2port_mapping[f.hub_relay_node] != NOT_VALID)
 	{
-		// ...to a destination which is connected to the Hub
-		if (GlobalParams::hub_configuration[local_id].attachedNodes[i]==f.dst_id)
-		{
-			return tile2Port(f.dst_id);
-		}
-		// ...or to a relay which is locally connected to the Hub
-		if (GlobalParams::hub_configuration[local_id].attachedNodes[i]==f.hub_relay_node)
-		{
-			assert(GlobalParams::winoc_dst_hops>0);
-			return tile2Port(f.hub_relay_node);
-		}
-
+		assert(GlobalParams::winoc_dst_hops>0);
+		return tile2port_mapping[f.hub_relay_node];
 	}
+
 	return DIRECTION_WIRELESS;
 
 }
@@ -62,14 +61,12 @@ void Hub::rxPowerManager()
 
 	for (unsigned int i=0;i<rxChannels.size();i++)
 	{
-		int ch_id = rxChannels[i];
-
-		if (!target[ch_id]->buffer_rx.IsEmpty())
+		if (!target[i]->buffer_rx.IsEmpty())
 		{
 			power.leakageAntennaBuffer();
 		}
 		else
-			buffer_rx_sleep_cycles[ch_id]++;
+			buffer_rx_sleep_cycles[i]++;
 	}
 
 	// Check wheter accounting antenna RX buffer
@@ -160,101 +157,102 @@ void Hub::updateTxPower()
 }
 
 
-void Hub::txRadioProcessTokenPacket(int channel)
+void Hub::txRadioProcessTokenPacket(int tx_slot)
 {
-    int current_holder = current_token_holder[channel]->read();
-    int current_channel_flag =flag[channel]->read();
+    int current_holder = current_token_holder[tx_slot]->read();
+    int current_channel_flag =flag[tx_slot]->read();
 
 	if ( current_holder == local_id && current_channel_flag !=RELEASE_CHANNEL)
 	{
-		if (!init[channel]->buffer_tx.IsEmpty())
+		if (!init[tx_slot]->buffer_tx.IsEmpty())
 		{
-			Flit flit = init[channel]->buffer_tx.Front();
+			Flit flit = init[tx_slot]->buffer_tx.Front();
 
-			// TODO: check whether it would make sense to use transmission_in_progress to
-			// avoid multiple notify()
-			LOG << "*** [Ch"<<channel<<"] Requesting transmission event of flit " << flit << endl;
-			init[channel]->start_request_event.notify();
+			// requests are ignored by the initiator while transmitting
+			LOG << "*** [Ch"<<txChannels[tx_slot]<<"] Requesting transmission event of flit " << flit << endl;
+			init[tx_slot]->requestTransmission();
 		}
 		else
 		{
-			if (!transmission_in_progress.at(channel))
+			if (!transmission_in_progress[tx_slot])
 			{
-				LOG << "*** [Ch"<<channel<<"] Buffer_tx empty and no trasmission in progress, releasing token" << endl;
-				flag[channel]->write(RELEASE_CHANNEL);
+				LOG << "*** [Ch"<<txChannels[tx_slot]<<"] Buffer_tx empty and no trasmission in progress, releasing token" << endl;
+				flag[tx_slot]->write(RELEASE_CHANNEL);
 			}
 			else
-				LOG << "*** [Ch"<<channel<<"] Buffer_tx empty, but trasmission in progress, holding token" << endl;
+				LOG << "*** [Ch"<<txChannels[tx_slot]<<"] Buffer_tx empty, but trasmission in progress, holding token" << endl;
 		}
 	}
 }
 
-void Hub::txRadioProcessTokenHold(int channel)
+void Hub::txRadioProcessTokenHold(int tx_slot)
 {
-	if (flag[channel]->read()==RELEASE_CHANNEL)
-		flag[channel]->write(HOLD_CHANNEL);
+	if (flag[tx_slot]->read()==RELEASE_CHANNEL)
+		flag[tx_slot]->write(HOLD_CHANNEL);
 
-	if (current_token_holder[channel]->read() == local_id)
+	if (current_token_holder[tx_slot]->read() == local_id)
 	{
-		if (!init[channel]->buffer_tx.IsEmpty())
+		if (!init[tx_slot]->buffer_tx.IsEmpty())
 		{
-			//LOG << "Token holder for channel " << channel << " with not empty buffer_tx" << endl;
-			if (current_token_expiration[channel]->read() < flit_transmission_cycles[channel])
+			//LOG << "Token holder for channel " << txChannels[tx_slot] << " with not empty buffer_tx" << endl;
+			if (token_ring->getTokenExpiration(tx_ring[tx_slot]) < flit_transmission_cycles[tx_slot])
 			{
-				//LOG << "TOKEN_HOLD policy: Not enough token expiration time for sending channel " << channel << endl;
+				//LOG << "TOKEN_HOLD policy: Not enough token expiration time for sending channel " << txChannels[tx_slot] << endl;
 			}
 			else
 			{
-				flag[channel]->write(HOLD_CHANNEL);
-				LOG << "*** [Ch" << channel << "] Starting transmission event" << endl;
-				init[channel]->start_request_event.notify();
+				flag[tx_slot]->write(HOLD_CHANNEL);
+				LOG << "*** [Ch" << txChannels[tx_slot] << "] Starting transmission event" << endl;
+				init[tx_slot]->requestTransmission();
 			}
 		}
 		else
 		{
-			//LOG << "TOKEN_HOLD policy: nothing to transmit, holding token for channel " << channel << endl;
+			//LOG << "TOKEN_HOLD policy: nothing to transmit, holding token for channel " << txChannels[tx_slot] << endl;
 		}
 	}
 }
 
-void Hub::txRadioProcessTokenMaxHold(int channel)
+void Hub::txRadioProcessTokenMaxHold(int tx_slot)
 {
-	if (flag[channel]->read()==RELEASE_CHANNEL)
-		flag[channel]->write(HOLD_CHANNEL);
+	if (flag[tx_slot]->read()==RELEASE_CHANNEL)
+		flag[tx_slot]->write(HOLD_CHANNEL);
 
-	if (current_token_holder[channel]->read() == local_id)
+	if (current_token_holder[tx_slot]->read() == local_id)
 	{
-		if (!init[channel]->buffer_tx.IsEmpty())
+		if (!init[tx_slot]->buffer_tx.IsEmpty())
 		{
-			//LOG << "Token holder for channel " << channel << " with not empty buffer_tx" << endl;
+			//LOG << "Token holder for channel " << txChannels[tx_slot] << " with not empty buffer_tx" << endl;
 
-			if (current_token_expiration[channel]->read() < flit_transmission_cycles[channel])
+			if (token_ring->getTokenExpiration(tx_ring[tx_slot]) < flit_transmission_cycles[tx_slot])
 			{
-				//LOG << "TOKEN_MAX_HOLD: Not enough token expiration time, releasing token for channel " << channel << endl;
-				flag[channel]->write(RELEASE_CHANNEL);
+				//LOG << "TOKEN_MAX_HOLD: Not enough token expiration time, releasing token for channel " << txChannels[tx_slot] << endl;
+				flag[tx_slot]->write(RELEASE_CHANNEL);
 			}
 			else
 			{
-				flag[channel]->write(HOLD_CHANNEL);
-				LOG << "Starting transmission on channel " << channel << endl;
-				init[channel]->start_request_event.notify();
+				flag[tx_slot]->write(HOLD_CHANNEL);
+				LOG << "Starting transmission on channel " << txChannels[tx_slot] << endl;
+				init[tx_slot]->requestTransmission();
 			}
 		}
 		else
 		{
-			//LOG << "TOKEN_MAX_HOLD: Buffer_tx empty, releasing token for channel " << channel << endl;
-			flag[channel]->write(RELEASE_CHANNEL);
+			//LOG << "TOKEN_MAX_HOLD: Buffer_tx empty, releasing token for channel " << txChannels[tx_slot] << endl;
+			flag[tx_slot]->write(RELEASE_CHANNEL);
 		}
 	}
 }
 
 void Hub::antennaToTileProcess()
 {
+	PROFILE_SCOPE(PROF_HUB);
+
 	if (reset.read())
 	{
 		for (int i = 0; i < num_ports; i++)
 		{
-			req_tx[i]->write(0);
+			link_tx[i]->writeReq(0);
 			current_level_tx[i] = 0;
 		}
 		return;
@@ -291,14 +289,13 @@ void Hub::antennaToTileProcess()
 				Flit flit = buffer_to_tile[i][vc].Front();
 
 				LOG << "Flit " << flit << " found on buffer_to_tile[" << i <<"][" << vc << "] " << endl;
-				if (current_level_tx[i] == ack_tx[i].read() &&
-					buffer_full_status_tx[i].read().mask[vc] == false)
+				if (current_level_tx[i] == link_tx[i]->readAck() &&
+					!link_tx[i]->readBufferFullStatus().isFull(vc))
 				{
-					LOG << "Flit " << flit << " moved from buffer_to_tile[" << i <<"][" << vc << "] to signal flit_tx["<<i<<"] " << endl;
+					LOG << "Flit " << flit << " moved from buffer_to_tile[" << i <<"][" << vc << "] to link_tx["<<i<<"] " << endl;
 
-					flit_tx[i].write(flit);
 					current_level_tx[i] = 1 - current_level_tx[i];
-					req_tx[i].write(current_level_tx[i]);
+					link_tx[i]->writeFlit(flit, current_level_tx[i]);
 
 					buffer_to_tile[i][vc].Pop();
 					power.bufferToTilePop();
@@ -307,7 +304,7 @@ void Hub::antennaToTileProcess()
 				}
 				else
 				{
-					LOG << "Flit " << flit << " cannot move from buffer_to_tile[" << i <<"] [" << vc << "] to signal flit_tx["<<i<<"] " << endl;
+					LOG << "Flit " << flit << " cannot move from buffer_to_tile[" << i <<"] [" << vc << "] to link_tx["<<i<<"] " << endl;
 				}
 			}//if buffer not empty
 		}
@@ -325,9 +322,9 @@ void Hub::antennaToTileProcess()
 	{
 		int channel = rxChannels[i];
 
-		if (!(target[channel]->buffer_rx.IsEmpty()))
+		if (!(target[i]->buffer_rx.IsEmpty()))
 		{
-			Flit received_flit = target[channel]->buffer_rx.Front();
+			Flit received_flit = target[i]->buffer_rx.Front();
 			power.antennaBufferFront();
 
 			// Check antenna buffer_rx making appropriate reservations
@@ -341,7 +338,7 @@ void Hub::antennaToTileProcess()
                     dst_port = tile2Port(received_flit.dst_id);
 
 				TReservation r;
-				r.input = channel;
+				r.input = i;
 				r.vc = received_flit.vc_id;
 
 				LOG << " Checking reservation availability of output port " << dst_port << " by channel " << channel << " for flit " << received_flit << endl;
@@ -375,7 +372,7 @@ void Hub::antennaToTileProcess()
 	for (unsigned int i = 0; i < rxChannels.size(); i++)
 	{
 		int channel = rxChannels[i];
-		vector<pair<int,int> > reservations = antenna2tile_reservation_table.getReservations(channel);
+		vector<pair<int,int> > reservations = antenna2tile_reservation_table.getReservations(i);
 
 		if (reservations.size()!=0)
 		{
@@ -384,14 +381,14 @@ void Hub::antennaToTileProcess()
 			int port = reservations[rnd_idx].first;
 			int vc = reservations[rnd_idx].second;
 
-			if (!(target[channel]->buffer_rx.IsEmpty()))
+			if (!(target[i]->buffer_rx.IsEmpty()))
 			{
-				Flit received_flit = target[channel]->buffer_rx.Front();
+				Flit received_flit = target[i]->buffer_rx.Front();
 				power.antennaBufferFront();
 
 				if ( !buffer_to_tile[port][vc].IsFull() )
 				{
-					target[channel]->buffer_rx.Pop();
+					target[i]->buffer_rx.Pop();
 					power.antennaBufferPop();
 					LOG << "*** [Ch" << channel << "] Moving flit  " << received_flit << " from buffer_rx to buffer_to_tile[" << port <<"][" << vc << "]" << endl;
 
@@ -402,7 +399,7 @@ void Hub::antennaToTileProcess()
 					{
 						LOG << "Releasing reservation for output port " << port << ", flit " << received_flit << endl;
 						TReservation r;
-						r.input = channel;
+						r.input = i;
 						r.vc = vc;
 						antenna2tile_reservation_table.release(r,port);
 					}
@@ -414,7 +411,7 @@ void Hub::antennaToTileProcess()
 			{
 				// should be ok
 				/*
-                LOG << "WARNING: empty target["<<channel<<"] buffer_rx, but reservation still present, if correct, remove assertion below " << endl;
+                LOG << "WARNING: empty target["<<i<<"] buffer_rx, but reservation still present, if correct, remove assertion below " << endl;
                 assert(false);
                 */
 			}
@@ -424,6 +421,8 @@ void Hub::antennaToTileProcess()
 
 void Hub::tileToAntennaProcess()
 {
+	PROFILE_SCOPE(PROF_HUB);
+
 	// double cycle = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
 	// if (cycle > 0 && cycle < 58428)
 	// {
@@ -440,16 +439,13 @@ void Hub::tileToAntennaProcess()
 	if (reset.read())
 	{
 		for (unsigned int i =0 ;i<txChannels.size();i++)
-		{
-			int channel = txChannels[i];
-			flag[channel]->write(HOLD_CHANNEL);
-		}
+			flag[i]->write(HOLD_CHANNEL);
 
-		TBufferFullStatus bfs;
 		for (int i = 0; i < num_ports; i++)
 		{
-			ack_rx[i]->write(0);
-			buffer_full_status_rx[i].write(bfs);
+			link_rx[i]->writeAck(0);
+			buffer_from_tile_full[i] = TBufferFullStatus();
+			link_rx[i]->writeBufferFullStatus(buffer_from_tile_full[i]);
 			current_level_rx[i] = 0;
 		}
 		return;
@@ -457,26 +453,22 @@ void Hub::tileToAntennaProcess()
 
 	for (unsigned int i =0 ;i<txChannels.size();i++)
 	{
-		int channel = txChannels[i];
-
-		string macPolicy = token_ring->getPolicy(channel).first;
-
-		if (macPolicy == TOKEN_PACKET)
-			txRadioProcessTokenPacket(channel);
-		else if (macPolicy == TOKEN_HOLD)
-			txRadioProcessTokenHold(channel);
-		else if (macPolicy == TOKEN_MAX_HOLD)
-			txRadioProcessTokenMaxHold(channel);
-		else
-			assert(false);
+		switch (tx_policy[i])
+		{
+		case TOKEN_POLICY_PACKET:
+			txRadioProcessTokenPacket(i);
+			break;
+		case TOKEN_POLICY_HOLD:
+			txRadioProcessTokenHold(i);
+			break;
+		case TOKEN_POLICY_MAX_HOLD:
+			txRadioProcessTokenMaxHold(i);
+			break;
+		}
 	}
 
 	int last_reserved = NOT_VALID;
-
-	// used to store routing decisions
-	int * r_from_tile[num_ports];
-	for (int i=0;i<num_ports;i++)
-		r_from_tile[i] = new int[GlobalParams::n_virtual_channels];
+	int n_vc = GlobalParams::n_virtual_channels;
 
 	// 1st phase: Reservation
 	for (int j = 0; j < num_ports; j++)
@@ -496,7 +488,7 @@ void Hub::tileToAntennaProcess()
 				assert(flit.vc_id == vc);
 
 				power.bufferFromTileFront();
-				r_from_tile[i][vc] = route(flit);
+				r_from_tile[i * n_vc + vc] = route(flit);
 
 				if (flit.flit_type == FLIT_TYPE_HEAD)
 				{
@@ -504,25 +496,26 @@ void Hub::tileToAntennaProcess()
 					r.input = i;
 					r.vc = vc;
 
-					assert(r_from_tile[i][vc]==DIRECTION_WIRELESS);
-					int channel;
+					assert(r_from_tile[i * n_vc + vc]==DIRECTION_WIRELESS);
+					int tx_slot;
 
 					if (flit.hub_relay_node==NOT_VALID)
-						channel = selectChannel(local_id, tile2Hub(flit.dst_id));
+						tx_slot = selectChannel(tile2Hub(flit.dst_id));
 					else
-						channel = selectChannel(local_id, tile2Hub(flit.hub_relay_node));
+						tx_slot = selectChannel(tile2Hub(flit.hub_relay_node));
 
 
-					assert(channel!=NOT_VALID && "hubs are not connected by any channel");
+					assert(tx_slot!=NOT_VALID && "hubs are not connected by any channel");
+					int channel = txChannels[tx_slot];
 
 					LOG << "Checking reservation availability of Channel " << channel << " by Hub port[" << i << "][" << vc << "] for flit " << flit << endl;
 
-					int rt_status = tile2antenna_reservation_table.checkReservation(r,channel);
+					int rt_status = tile2antenna_reservation_table.checkReservation(r,tx_slot);
 
 					if (rt_status == RT_AVAILABLE)
 					{
 						LOG << "Reservation of channel " << channel << " from Hub port["<< i << "]["<<vc<<"] by flit " << flit << endl;
-						tile2antenna_reservation_table.reserve(r, channel);
+						tile2antenna_reservation_table.reserve(r, tx_slot);
 					}
 					else if (rt_status == RT_ALREADY_SAME)
 					{
@@ -563,24 +556,27 @@ void Hub::tileToAntennaProcess()
 				Flit flit = buffer_from_tile[i][vc].Front();
 				// powerFront already accounted in 1st phase
 
-				assert(r_from_tile[i][vc] == DIRECTION_WIRELESS);
+				assert(r_from_tile[i * n_vc + vc] == DIRECTION_WIRELESS);
 
-				int channel =  o;
+				int tx_slot =  o;
 
-				if (channel != NOT_RESERVED)
+				if (tx_slot != NOT_RESERVED)
 				{
-					if (!(init[channel]->buffer_tx.IsFull()) )
+					int channel = txChannels[tx_slot];
+
+					if (!(init[tx_slot]->buffer_tx.IsFull()) )
 					{
 						buffer_from_tile[i][vc].Pop();
+						buffer_from_tile_full[i].clearFull(vc);
 						power.bufferFromTilePop();
-						init[channel]->buffer_tx.Push(flit);
+						init[tx_slot]->buffer_tx.Push(flit);
 						power.antennaBufferPush();
 						if (flit.flit_type == FLIT_TYPE_TAIL)
 						{
 							TReservation r;
 							r.input = i;
 							r.vc = vc;
-							tile2antenna_reservation_table.release(r,channel);
+							tile2antenna_reservation_table.release(r,tx_slot);
 						}
 
 						LOG << "Flit " << flit << " moved from buffer_from_tile["<<i<<"]["<<vc<<"]  to buffer_tx["<<channel<<"] " << endl;
@@ -603,11 +599,11 @@ void Hub::tileToAntennaProcess()
 	for (int i = 0; i < num_ports; i++)
 	{
 
-		if (req_rx[i]->read() == 1 - current_level_rx[i])
+		if (link_rx[i]->readReq() == 1 - current_level_rx[i])
 		{
-			Flit received_flit = flit_rx[i]->read();
+			Flit received_flit = link_rx[i]->readFlit();
 			int vc = received_flit.vc_id;
-			LOG << "Reading " << received_flit << " from signal flit_rx[" << i << "]" << endl;
+			LOG << "Reading " << received_flit << " from link_rx[" << i << "]" << endl;
 
 			/*
             if (!buffer_from_tile[i][vc].deadlockFree())
@@ -622,6 +618,8 @@ void Hub::tileToAntennaProcess()
 				LOG << "Storing " << received_flit << " on buffer_from_tile[" << i << "][" << vc << "]" << endl;
 
 				buffer_from_tile[i][vc].Push(received_flit);
+				if (buffer_from_tile[i][vc].IsFull())
+					buffer_from_tile_full[i].setFull(vc);
 				power.bufferFromTilePush();
 
 				current_level_rx[i] = 1 - current_level_rx[i];
@@ -632,12 +630,9 @@ void Hub::tileToAntennaProcess()
 				//buffer_from_tile[i][TODO_VC].Print();
 			}
 		}
-		ack_rx[i]->write(current_level_rx[i]);
+		link_rx[i]->writeAck(current_level_rx[i]);
 		// updates the mask of VCs to prevent incoming data on full buffers
-		TBufferFullStatus bfs;
-		for (int vc=0;vc<GlobalParams::n_virtual_channels;vc++)
-			bfs.mask[vc] = buffer_from_tile[i][vc].IsFull();
-		buffer_full_status_rx[i].write(bfs);
+		link_rx[i]->writeBufferFullStatus(buffer_from_tile_full[i]);
 	}
 
 	// IMPORTANT: do not move from here
@@ -645,21 +640,10 @@ void Hub::tileToAntennaProcess()
 	updateTxPower();
 }
 
-int Hub::selectChannel(int src_hub, int dst_hub) const
+int Hub::selectChannel(int dst_hub) const
 {
-	vector<int> & first = GlobalParams::hub_configuration[src_hub].txChannels;
-	vector<int> & second = GlobalParams::hub_configuration[dst_hub].rxChannels;
-
-	vector<int> intersection;
-
-	for (unsigned int i=0;i<first.size();i++)
-	{
-		for (unsigned int j=0;j<second.size();j++)
-		{
-			if (first[i] ==second[j])
-				intersection.push_back(first[i]);
-		}
-	}
+	assert(dst_hub < (int)tx_slots_to_hub.size());
+	const vector<int> & intersection = tx_slots_to_hub[dst_hub];
 
 	if (intersection.size()==0)
 	    return NOT_VALID;
@@ -676,9 +660,9 @@ int Hub::selectChannel(int src_hub, int dst_hub) const
 		{
 			k = (start_channel+i)%intersection.size();
 
-			if (!transmission_in_progress.at(intersection[k]))
+			if (!transmission_in_progress[intersection[k]])
 			{
-				cout << "Found free channel " << intersection[k] << " on (src,dest) (" << src_hub << "," << dst_hub << ") " << endl;
+				cout << "Found free channel " << txChannels[intersection[k]] << " on (src,dest) (" << local_id << "," << dst_hub << ") " << endl;
 				return intersection[k];
 			}
 		}
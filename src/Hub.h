@@ -14,6 +14,7 @@
 #include <map>
 #include <systemc.h>
 #include "DataStructs.h"
+#include "LinkChannel.h"
 #include "Buffer.h"
 #include "ReservationTable.h"
 
@@ -39,32 +40,28 @@ SC_MODULE(Hub)
     vector<int> txChannels;
     vector<int> rxChannels;
 
-    sc_in<Flit>* flit_rx;
-    sc_in<bool>* req_rx;
-    sc_out<bool>* ack_rx;
-    sc_out<TBufferFullStatus>* buffer_full_status_rx;
-
-    sc_out<Flit>* flit_tx;
-    sc_out<bool>* req_tx;	   
-    sc_in<bool>* ack_tx;	  
-    sc_in<TBufferFullStatus>* buffer_full_status_tx;
+    sc_port<LinkRxIf>* link_rx;	// Links from the attached tiles
+    sc_port<LinkTxIf>* link_tx;	// Links to the attached tiles
 
     BufferBank* buffer_from_tile;   // Buffer for each port
     BufferBank* buffer_to_tile;     // Buffer for each port
     bool* current_level_rx;	// Current level for ABP
+    TBufferFullStatus* buffer_from_tile_full;	// Full VCs of each buffer_from_tile, updated on push/pop
     bool* current_level_tx;	// Current level for ABP
 
 
-    map<int, sc_in<int>* > current_token_holder;
-    map<int, sc_in<int>* > current_token_expiration;
-    map<int, sc_inout<int>* > flag;
-    map<int, bool> transmission_in_progress;
+    // Per tx channel state, indexed by the position of the channel in
+    // txChannels (tx slot)
+    Initiator** init;
+    sc_in<int>** current_token_holder;
+    sc_inout<int>** flag;
+    bool* transmission_in_progress;
 
-    map<int, Initiator*> init;
-    map<int, Target*> target;
+    // Per rx channel state, indexed by the position of the channel in
+    // rxChannels (rx slot)
+    Target** target;
 
-    map<int, int> tile2port_mapping;
-    map<int, int> tile2hub_mapping;
+    vector<int> tile2port_mapping;	// port of each attached tile, by tile id
 
     int start_from_port; // Port from which to start the reservation cycle
     int * start_from_vc; // VC from which to start the reservation cycle for the specific port
@@ -80,17 +77,17 @@ SC_MODULE(Hub)
     int route(Flit&);
     int tile2Port(int);
 
-    void setFlitTransmissionCycles(int cycles,int ch_id) {flit_transmission_cycles[ch_id]=cycles;}
+    void setFlitTransmissionCycles(int cycles,int tx_slot) {flit_transmission_cycles[tx_slot]=cycles;}
 
     // Power stats
     Power power;
 
     int total_sleep_cycles;
     int total_ttxoff_cycles;
-    map<int,int> buffer_rx_sleep_cycles; // antenna buffer RX power off cycles
-    map<int,int> abtxoff_cycles; // antenna buffer TX power off cycles
-    map<int,int> analogtxoff_cycles; // analog TX power off cycles
-    map<int,int> buffer_to_tile_poweroff_cycles;
+    int* buffer_rx_sleep_cycles; // antenna buffer RX power off cycles, by rx slot
+    int* abtxoff_cycles; // antenna buffer TX power off cycles, by tx slot
+    int* analogtxoff_cycles; // analog TX power off cycles, by tx slot
+    int* buffer_to_tile_poweroff_cycles; // by port
 
     int wireless_communications_counter;
 
@@ -117,21 +114,13 @@ SC_MODULE(Hub)
         rxChannels = GlobalParams::hub_configuration[local_id].rxChannels;
         txChannels = GlobalParams::hub_configuration[local_id].txChannels;
 
+	// inputs are rx slots, outputs the ports to the tiles
 	antenna2tile_reservation_table.setSize(num_ports);
-	// fix this
-	//tile2antenna_reservation_table.setSize(txChannels.size());
-#define STATIC_MAX_CHANNELS 100
-      tile2antenna_reservation_table.setSize(STATIC_MAX_CHANNELS);
-
-        flit_rx = new sc_in<Flit>[num_ports];
-        req_rx = new sc_in<bool>[num_ports];
-        ack_rx = new sc_out<bool>[num_ports];
-        buffer_full_status_rx = new sc_out<TBufferFullStatus>[num_ports];
+	// inputs are the ports from the tiles, outputs tx slots
+	tile2antenna_reservation_table.setSize(txChannels.size());
 
-        flit_tx = new sc_out<Flit>[num_ports];
-        req_tx = new sc_out<bool>[num_ports];
-        ack_tx = new sc_in<bool>[num_ports];
-        buffer_full_status_tx = new sc_in<TBufferFullStatus>[num_ports];
+        link_rx = new sc_port<LinkRxIf>[num_ports];
+        link_tx = new sc_port<LinkTxIf>[num_ports];
 
         buffer_from_tile = new BufferBank[num_ports];
         buffer_to_tile = new BufferBank[num_ports];
@@ -140,7 +129,15 @@ SC_MODULE(Hub)
 
 
         current_level_rx = new bool[num_ports];
+        buffer_from_tile_full = new TBufferFullStatus[num_ports];
         current_level_tx = new bool[num_ports];
+        r_from_tile = new int[num_ports * GlobalParams::n_virtual_channels];
+        buffer_to_tile_poweroff_cycles = new int[num_ports]();
+
+        int max_tile = NOT_VALID;
+        for (int i = 0; i < num_ports; i++)
+            max_tile = max(max_tile, attachedNodes[i]);
+        tile2port_mapping.assign(max_tile + 1, NOT_VALID);
 
         start_from_port = 0;
 
@@ -156,29 +153,59 @@ SC_MODULE(Hub)
             start_from_vc[i] = 0;
         }
 
-        for (unsigned int i = 0; i < txChannels.size(); i++) {
+        int num_tx = txChannels.size();
+        init = new Initiator*[num_tx];
+        current_token_holder = new sc_in<int>*[num_tx];
+        flag = new sc_inout<int>*[num_tx];
+        transmission_in_progress = new bool[num_tx];
+        tx_policy = new TokenPolicyType[num_tx];
+        tx_ring = new int[num_tx];
+        flit_transmission_cycles = new int[num_tx]();
+        abtxoff_cycles = new int[num_tx]();
+        analogtxoff_cycles = new int[num_tx]();
+
+        for (int i = 0; i < num_tx; i++) {
             char txt[20];
             int ch = txChannels[i];
             sprintf(txt, "init_%d", ch);
-            init[ch] = new Initiator(txt,this);
-            init[ch]->buffer_tx.SetMaxBufferSize(GlobalParams::hub_configuration[local_id].txBufferSize);
-            init[ch]->buffer_tx.setLabel(string(name())+"->abtx["+i_to_string(i)+"]");
-            current_token_holder[ch] = new sc_in<int>();
-            current_token_expiration[ch] = new sc_in<int>();
-            flag[ch] = new sc_inout<int>();
-            token_ring->attachHub(ch,local_id, current_token_holder[ch],current_token_expiration[ch],flag[ch]);
-            transmission_in_progress[ch] = false;
+            init[i] = new Initiator(txt,this,i);
+            init[i]->buffer_tx.SetMaxBufferSize(GlobalParams::hub_configuration[local_id].txBufferSize);
+            init[i]->buffer_tx.setLabel(string(name())+"->abtx["+i_to_string(i)+"]");
+            current_token_holder[i] = new sc_in<int>();
+            flag[i] = new sc_inout<int>();
+            tx_ring[i] = token_ring->attachHub(ch,local_id, current_token_holder[i],flag[i]);
+            transmission_in_progress[i] = false;
+            tx_policy[i] = token_ring->getPolicy(ch).type;
             // power manager currently assumes TOKEN_PACKET mac policy
             if (GlobalParams::use_powermanager)
-                assert(token_ring->getPolicy(ch).first==TOKEN_PACKET);
+                assert(tx_policy[i]==TOKEN_POLICY_PACKET);
+        }
+
+        // tx slots through which each hub can be reached, by hub id
+        for (map<int, HubConfig>::iterator it = GlobalParams::hub_configuration.begin();
+                it != GlobalParams::hub_configuration.end();
+                ++it) {
+            vector<int> & rx = it->second.rxChannels;
+
+            if (it->first >= (int)tx_slots_to_hub.size())
+                tx_slots_to_hub.resize(it->first + 1);
+
+            for (int i = 0; i < num_tx; i++)
+                for (unsigned int j = 0; j < rx.size(); j++)
+                    if (txChannels[i] == rx[j])
+                        tx_slots_to_hub[it->first].push_back(i);
         }
 
-        for (unsigned int i = 0; i < rxChannels.size(); i++) {
+        int num_rx = rxChannels.size();
+        target = new Target*[num_rx];
+        buffer_rx_sleep_cycles = new int[num_rx]();
+
+        for (int i = 0; i < num_rx; i++) {
             char txt[20];
             sprintf(txt, "target_%d", rxChannels[i]);
-            target[rxChannels[i]] = new Target(txt, rxChannels[i], this);
-            target[rxChannels[i]]->buffer_rx.SetMaxBufferSize(GlobalParams::hub_configuration[local_id].rxBufferSize);
-            target[rxChannels[i]]->buffer_rx.setLabel(string(name())+"->abrx["+i_to_string(i)+"]");
+            target[i] = new Target(txt, rxChannels[i], this);
+            target[i]->buffer_rx.SetMaxBufferSize(GlobalParams::hub_configuration[local_id].rxBufferSize);
+            target[i]->buffer_rx.setLabel(string(name())+"->abrx["+i_to_string(i)+"]");
         }
 
 	start_from_port = 0;
@@ -191,16 +218,20 @@ SC_MODULE(Hub)
     int getID() { return local_id;}
 
     private:
-    map<int,int> flit_transmission_cycles;
+    int* flit_transmission_cycles;	// by tx slot
+    TokenPolicyType* tx_policy;		// by tx slot
+    int* tx_ring;			// token ring index, by tx slot
+    vector<vector<int> > tx_slots_to_hub;
+    int* r_from_tile;			// routing decisions, [port * n_vc + vc]
 
-    void txRadioProcessTokenPacket(int channel);
-    void txRadioProcessTokenHold(int channel);
-    void txRadioProcessTokenMaxHold(int channel);
+    void txRadioProcessTokenPacket(int tx_slot);
+    void txRadioProcessTokenHold(int tx_slot);
+    void txRadioProcessTokenMaxHold(int tx_slot);
 
     void rxPowerManager();
     void txPowerManager();
 
-    int selectChannel(int src, int dst) const ;
+    int selectChannel(int dst_hub) const;	// tx slot towards dst_hub
 };
 
 #endif
@@ -10,94 +10,107 @@
 #include "Hub.h"
 #include "Initiator.h"
 
-void Initiator::thread_process()
+void Initiator::requestTransmission()
 {
+	if (transmitting) return;
 
-	tlm::tlm_generic_payload* trans = new tlm::tlm_generic_payload;
-	tlm::tlm_phase phase;
-	sc_time delay;
+	transmitting = true;
+	// started once all the clocked processes of this cycle have run
+	start_request_event.notify(SC_ZERO_TIME);
+}
+
+void Initiator::startTransmission()
+{
+	tlm::tlm_command cmd = tlm::TLM_WRITE_COMMAND;
+	flit_payload = buffer_tx.Front();
+	hub->power.antennaBufferFront();
 
-	while (1)
+	// hub relay management  ////////////////////////////////////////////////////////////////
+	// if explicitly set in the header flit, trasmission target should reach a relay hub
+	if (flit_payload.flit_type == FLIT_TYPE_HEAD)
 	{
-		LOG << " *** waiting for transmissions" << endl;
+		if (flit_payload.hub_relay_node!=NOT_VALID) {
+			current_hub_relay = flit_payload.hub_relay_node;
+			LOG << "HUB RELAY: Flit " << flit_payload << " setting transmission hub relay " << current_hub_relay << " to reach destination " << endl;
+		}
+		else
+			current_hub_relay = NOT_VALID;
+	}
 
-		wait(start_request_event);
+	if (current_hub_relay!=NOT_VALID)
+	{
+		flit_payload.hub_relay_node = current_hub_relay;
+		dest_hub = tile2Hub(flit_payload.hub_relay_node);
+	}
+	else
+	{
+		dest_hub = tile2Hub(flit_payload.dst_id);
+	}
+	////////////////////////////////////////////////////////////////////////////////
 
-		tlm::tlm_command cmd = tlm::TLM_WRITE_COMMAND;
-		flit_payload = buffer_tx.Front();
-		hub->power.antennaBufferFront();
 
-		int destHub;
+	LOG << " *** Starting transmission of " << flit_payload << " to reach HUB_" << dest_hub <<  endl;
 
-		// hub relay management  ////////////////////////////////////////////////////////////////
-		// if explicitly set in the header flit, trasmission target should reach a relay hub
-		if (flit_payload.flit_type == FLIT_TYPE_HEAD)
-		{
-			if (flit_payload.hub_relay_node!=NOT_VALID) {
-				current_hub_relay = flit_payload.hub_relay_node;
-				LOG << "HUB RELAY: Flit " << flit_payload << " setting transmission hub relay " << current_hub_relay << " to reach destination " << endl;
-			}
-			else
-				current_hub_relay = NOT_VALID;
-		}
+	trans->set_command(cmd);
+	trans->set_address(static_cast<const uint64>(dest_hub));
 
-		if (current_hub_relay!=NOT_VALID)
-		{
-			flit_payload.hub_relay_node = current_hub_relay;
-			destHub = tile2Hub(flit_payload.hub_relay_node);
-		}
-		else
-		{
-			destHub = tile2Hub(flit_payload.dst_id);
-		}
-		////////////////////////////////////////////////////////////////////////////////
+	trans->set_data_ptr( reinterpret_cast<unsigned char*>(&flit_payload) );
+	trans->set_data_length( sizeof(Flit) );
+	trans->set_streaming_width( sizeof(Flit) ); // = data_length to indicate no streaming
+	trans->set_byte_enable_ptr( 0 ); // 0 indicates unused
+	trans->set_dmi_allowed( false ); // Mandatory initial value
+	trans->set_response_status( tlm::TLM_INCOMPLETE_RESPONSE ); // Mandatory initial value
 
+	tlm::tlm_phase phase = tlm::BEGIN_REQ;
+	sc_time delay = SC_ZERO_TIME;
 
-		LOG << " *** Starting transmission of " << flit_payload << " to reach HUB_" << destHub <<  endl;
+	// The channel accepts the request and responds on the backward path
+	// at the end of the transmission, or completes it at once with an
+	// error if the destination hub is not on the channel
+	tlm::tlm_sync_enum status = socket->nb_transport_fw( *trans, phase, delay);
+	if (status == tlm::TLM_COMPLETED)
+		endTransmission(*trans);
+	else
+		assert(status == tlm::TLM_UPDATED);
+}
 
-		trans->set_command(cmd);
-		trans->set_address(static_cast<const uint64>(destHub));
+tlm::tlm_sync_enum Initiator::nb_transport_bw(tlm::tlm_generic_payload& trans,
+					      tlm::tlm_phase& phase, sc_time& delay)
+{
+	assert(phase == tlm::BEGIN_RESP);
 
-		trans->set_data_ptr( reinterpret_cast<unsigned char*>(&flit_payload) );
-		trans->set_data_length( sizeof(Flit) );
-		trans->set_streaming_width( sizeof(Flit) ); // = data_length to indicate no streaming
-		trans->set_byte_enable_ptr( 0 ); // 0 indicates unused
-		trans->set_dmi_allowed( false ); // Mandatory initial value
-		trans->set_response_status( tlm::TLM_INCOMPLETE_RESPONSE ); // Mandatory initial value
+	endTransmission(trans);
 
-		delay = sc_time(0, SC_PS);
+	phase = tlm::END_RESP;
+	return tlm::TLM_COMPLETED;
+}
 
-		// Call b_transport to demonstrate the b/nb conversion by the simple_target_socket
-		socket->b_transport( *trans, delay);
+void Initiator::endTransmission(tlm::tlm_generic_payload& trans)
+{
+	hub->power.wirelessTx(hub->local_id,dest_hub,GlobalParams::flit_size);
 
-		hub->power.wirelessTx(hub->local_id,destHub,GlobalParams::flit_size);
+	// Initiator obliged to check response status
+	if (!trans.is_response_error() )
+	{
+		buffer_tx.Pop();
+		hub->power.antennaBufferPop();
 
-		// Initiator obliged to check response status and delay
-		if (!trans->is_response_error() )
-		{
-			buffer_tx.Pop();
-			hub->power.antennaBufferPop();
-
-			if (flit_payload.flit_type == FLIT_TYPE_HEAD)
-				hub->transmission_in_progress.at(_channel_id) = true;
-
-			if (flit_payload.flit_type == FLIT_TYPE_TAIL)
-			{
-				LOG << "*** [Ch"<< _channel_id <<"] tail flit sent " << flit_payload << ", releasing token" << endl;
-				hub->flag[_channel_id]->write(RELEASE_CHANNEL);
-				hub->transmission_in_progress.at(_channel_id) = false;
-			}
-		}
-		else
+		if (flit_payload.flit_type == FLIT_TYPE_HEAD)
+			hub->transmission_in_progress[_tx_slot] = true;
+
+		if (flit_payload.flit_type == FLIT_TYPE_TAIL)
 		{
-			LOG << " WARNING: incomplete transaction " << endl;
+			LOG << "*** [Ch"<< _channel_id <<"] tail flit sent " << flit_payload << ", releasing token" << endl;
+			hub->flag[_tx_slot]->write(RELEASE_CHANNEL);
+			hub->transmission_in_progress[_tx_slot] = false;
 		}
-
-		//check_transaction( *trans );
-
+	}
+	else
+	{
+		LOG << " WARNING: incomplete transaction " << endl;
 	}
 
-}
-
-
+	//check_transaction( trans );
 
+	transmitting = false;
+}
@@ -25,7 +25,10 @@ using namespace std;
 struct Hub;
 
 // **************************************************************************************
-// Initiator module generating multiple pipelined generic payload transactions
+// Initiator module transmitting the flits of a hub on a wireless channel.
+// Transmissions are method-based: the hub requests them, the flit is sent
+// with a non-blocking BEGIN_REQ and the channel answers with BEGIN_RESP on
+// the backward path once the transmission delay has elapsed
 // **************************************************************************************
 
 struct Initiator: sc_module
@@ -38,29 +41,48 @@ struct Initiator: sc_module
 
   //SC_CTOR(Initiator)
   //: socket("socket")  // Construct and name socket
-  Initiator(sc_module_name nm,Hub* h): sc_module(nm),hub(h), socket("socket")
+  Initiator(sc_module_name nm,Hub* h,int tx_slot): sc_module(nm),hub(h), socket("socket")
   {
 
       int c;
-      if (GlobalParams::use_winoc) SC_THREAD(thread_process);
+      if (GlobalParams::use_winoc)
+      {
+	  SC_METHOD(startTransmission);
+	  sensitive << start_request_event;
+	  dont_initialize();
+      }
+      socket.register_nb_transport_bw(this, &Initiator::nb_transport_bw);
       sscanf(nm,"init_%d",&c);
       _channel_id = c;
+      _tx_slot = tx_slot;
       current_hub_relay = NOT_VALID;
+      transmitting = false;
+      trans = new tlm::tlm_generic_payload;
   }
 
-  void thread_process();
-  void check_transaction(tlm::tlm_generic_payload& trans);
-
-  sc_event end_request_event;
+  // Requests the transmission of the flit at the front of buffer_tx.
+  // Ignored while a transmission is in progress
+  void requestTransmission();
 
-  // custom
-  sc_event start_request_event;
+  void check_transaction(tlm::tlm_generic_payload& trans);
 
   Buffer buffer_tx;
   Flit flit_payload; 
 
     private: 
+  void startTransmission();
+  tlm::tlm_sync_enum nb_transport_bw(tlm::tlm_generic_payload& trans,
+				     tlm::tlm_phase& phase, sc_time& delay);
+  // Checks the response status and gets ready for the next transmission
+  void endTransmission(tlm::tlm_generic_payload& trans);
+
+  sc_event start_request_event;
+  tlm::tlm_generic_payload* trans;
+  bool transmitting;
+  int dest_hub;
+
   int _channel_id;
+  int _tx_slot;		// position of the channel in the txChannels of the hub
   int current_hub_relay;
 };
 
@@ -0,0 +1,64 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the injection schedule recorder
+ */
+
+#include "InjectionRecorder.h"
+#include <cstring>
+
+void InjectionRecorder::record(const int src, const uint32_t cycle, const Packet & packet)
+{
+    if ((size_t) src >= entries.size()) {
+	entries.resize(src + 1);
+	shapes.resize(src + 1);
+    }
+
+    HardcodedTraceEntry entry;
+    entry.cycle = cycle;
+    entry.dst = packet.dst_id;
+    entries[src].push_back(entry);
+
+    HardcodedTraceShape shape;
+    shape.size = packet.size;
+    shape.vc = packet.vc_id;
+    shapes[src].push_back(shape);
+
+    if (cycle >= n_cycles)
+	n_cycles = cycle + 1;
+}
+
+bool InjectionRecorder::save(const char *fname) const
+{
+    FILE *out = fopen(fname, "wb");
+    if (out == NULL)
+	return false;
+
+    HardcodedTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HARDCODED_TRACE_MAGIC, sizeof(header.magic));
+    header.num_cycles = n_cycles;
+    header.num_sources = entries.size();
+    header.flags = HARDCODED_TRACE_SHAPED;
+
+    vector<uint64_t> first(entries.size() + 1, 0);
+    for (size_t s = 0; s < entries.size(); s++)
+	first[s + 1] = first[s] + entries[s].size();
+
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+	fwrite(&first[0], sizeof(uint64_t), first.size(), out) == first.size();
+
+    for (size_t s = 0; ok && s < entries.size(); s++)
+	ok = entries[s].empty() ||
+	    fwrite(&entries[s][0], sizeof(HardcodedTraceEntry), entries[s].size(), out) == entries[s].size();
+
+    for (size_t s = 0; ok && s < shapes.size(); s++)
+	ok = shapes[s].empty() ||
+	    fwrite(&shapes[s][0], sizeof(HardcodedTraceShape), shapes[s].size(), out) == shapes[s].size();
+
+    return fclose(out) == 0 && ok;
+}
@@ -0,0 +1,44 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the injection schedule recorder
+ */
+
+#ifndef __NOXIMINJECTIONRECORDER_H__
+#define __NOXIMINJECTIONRECORDER_H__
+
+#include <vector>
+#include "DataStructs.h"
+#include "HardcodedTrace.h"
+
+using namespace std;
+
+// Records the packets offered by every PE, i.e. generated before the
+// source queue policy applies, with their size and virtual channel. The
+// schedule is saved as a shaped binary hardcoded trace: replayed with
+// "-traffic hardcoded", it injects the same packets whatever the routers
+// do with them
+class InjectionRecorder {
+
+  public:
+
+    InjectionRecorder() { n_cycles = 0; }
+
+    // cycle counts from the end of the reset
+    void record(const int src, const uint32_t cycle, const Packet & packet);
+
+    // Returns true if ok, false otherwise
+    bool save(const char *fname) const;
+
+  private:
+
+    vector<vector<HardcodedTraceEntry> > entries;	// per source, by cycle
+    vector<vector<HardcodedTraceShape> > shapes;
+    uint64_t n_cycles;
+};
+
+#endif
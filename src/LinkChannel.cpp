@@ -0,0 +1,56 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the link channel
+ */
+
+#include "LinkChannel.h"
+
+LinkChannel::LinkChannel():sc_prim_channel(sc_gen_unique_name("link"))
+{
+    init();
+}
+
+LinkChannel::LinkChannel(const char *name):sc_prim_channel(name)
+{
+    init();
+}
+
+void LinkChannel::init()
+{
+    // Until the receiver writes them, free slots and NoP data are not valid
+    // (e.g. mesh borders, where nobody ever writes them)
+    current.flit = Flit();
+    current.req = false;
+    current.ack = false;
+    current.free_slots = NOT_VALID;
+    current.nop_data.sender_id = NOT_VALID;
+    current.nop_data.available_mask = 0;
+    for (int i = 0; i < DIRECTIONS; i++)
+	current.nop_data.free_slots[i] = NOT_VALID;
+
+    next = current;
+    dirty = 0;
+}
+
+void LinkChannel::update()
+{
+    if (dirty & DIRTY_FLIT)
+	current.flit = next.flit;
+    if (dirty & DIRTY_REQ)
+	current.req = next.req;
+    if (dirty & DIRTY_ACK)
+	current.ack = next.ack;
+    if (dirty & DIRTY_BFS)
+	current.buffer_full_status = next.buffer_full_status;
+    if (dirty & DIRTY_FREE_SLOTS)
+	current.free_slots = next.free_slots;
+    if (dirty & DIRTY_NOP)
+	current.nop_data = next.nop_data;
+
+    dirty = 0;
+}
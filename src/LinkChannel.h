@@ -0,0 +1,142 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the link channel
+ */
+
+#ifndef __NOXIMLINKCHANNEL_H__
+#define __NOXIMLINKCHANNEL_H__
+
+#include <systemc.h>
+#include "DataStructs.h"
+
+using namespace std;
+
+// Whole state of a unidirectional link. flit and req are driven by the
+// transmitter, the other fields by the receiver
+struct LinkState {
+    Flit flit;
+    bool req;				// ABP level of the transmitter
+    bool ack;				// ABP level of the receiver
+    TBufferFullStatus buffer_full_status;	// full VCs of the receiver input buffer
+    int free_slots;			// free slots of the receiver input buffer
+    NoP_data nop_data;			// Neighbors-on-Path data of the receiver
+};
+
+// Interface seen by the transmitter of a link
+class LinkTxIf : virtual public sc_interface {
+
+  public:
+
+    virtual void writeFlit(const Flit & flit, const bool req) = 0;
+    virtual void writeReq(const bool req) = 0;
+
+    virtual bool readAck() const = 0;
+    virtual const TBufferFullStatus & readBufferFullStatus() const = 0;
+    virtual int readFreeSlots() const = 0;
+    virtual const NoP_data & readNoPData() const = 0;
+};
+
+// Interface seen by the receiver of a link
+class LinkRxIf : virtual public sc_interface {
+
+  public:
+
+    virtual const Flit & readFlit() const = 0;
+    virtual bool readReq() const = 0;
+
+    virtual void writeAck(const bool ack) = 0;
+    virtual void writeBufferFullStatus(const TBufferFullStatus & bfs) = 0;
+    virtual void writeFreeSlots(const int free_slots) = 0;
+    virtual void writeNoPData(const NoP_data & nop_data) = 0;
+};
+
+// Replaces the flit/req/ack/buffer_full_status/free_slots/nop_data signals
+// of a link. Writes go to the next state and become visible after the
+// update phase, as for sc_signal, but a single update is requested per
+// delta cycle and no event is notified: all the processes reading links
+// are clocked.
+class LinkChannel : public sc_prim_channel, public LinkTxIf, public LinkRxIf {
+
+  public:
+
+    LinkChannel();
+    explicit LinkChannel(const char *name);
+
+    // Transmitter side
+    void writeFlit(const Flit & flit, const bool req) {
+	next.flit = flit;
+	next.req = req;
+	touch(DIRTY_FLIT | DIRTY_REQ);
+    }
+    void writeReq(const bool req) { next.req = req; touch(DIRTY_REQ); }
+
+    bool readAck() const { return current.ack; }
+    const TBufferFullStatus & readBufferFullStatus() const { return current.buffer_full_status; }
+    int readFreeSlots() const { return current.free_slots; }
+    const NoP_data & readNoPData() const { return current.nop_data; }
+
+    // Receiver side
+    const Flit & readFlit() const { return current.flit; }
+    bool readReq() const { return current.req; }
+
+    void writeAck(const bool ack) { next.ack = ack; touch(DIRTY_ACK); }
+    void writeBufferFullStatus(const TBufferFullStatus & bfs) {
+	next.buffer_full_status = bfs;
+	touch(DIRTY_BFS);
+    }
+    void writeFreeSlots(const int free_slots) { next.free_slots = free_slots; touch(DIRTY_FREE_SLOTS); }
+    void writeNoPData(const NoP_data & nop_data) { next.nop_data = nop_data; touch(DIRTY_NOP); }
+
+    // Current state (e.g. for sc_trace)
+    const LinkState & read() const { return current; }
+
+    // Partitioned runs: the fields driven by a transmitter or a receiver
+    // simulated by another process, as committed in its own copy of the
+    // link. They are never written locally, so they bypass the update
+    void importTx(const Flit & flit, const bool req) {
+	current.flit = flit;
+	current.req = req;
+    }
+    void importRx(const LinkState & state) {
+	current.ack = state.ack;
+	current.buffer_full_status = state.buffer_full_status;
+	current.free_slots = state.free_slots;
+	current.nop_data = state.nop_data;
+    }
+
+    const char *kind() const { return "LinkChannel"; }
+
+  protected:
+
+    void update();
+
+  private:
+
+    enum {
+	DIRTY_FLIT = 1,
+	DIRTY_REQ = 2,
+	DIRTY_ACK = 4,
+	DIRTY_BFS = 8,
+	DIRTY_FREE_SLOTS = 16,
+	DIRTY_NOP = 32
+    };
+
+    LinkState current;
+    LinkState next;
+    unsigned int dirty;		// fields written in this delta cycle
+
+    void init();
+
+    inline void touch(const unsigned int fields) {
+	if (dirty == 0)
+	    request_update();
+	dirty |= fields;
+    }
+};
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the load-latency sweep
+ */
+
+#include "LoadSweep.h"
+#include "RunLengthController.h"
+#include "GlobalStats.h"
+
+#include <algorithm>
+
+LoadSweep::LoadSweep(NoC * _noc)
+{
+    noc = _noc;
+
+    if (GlobalParams::topology == TOPOLOGY_MESH)
+	n_sources = GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y;
+    else
+	n_sources = GlobalParams::n_delta_tiles;
+
+    // Keep the temporal distribution selected with -pir (e.g. burst)
+    if (GlobalParams::packet_injection_rate > 0)
+	por_ratio = GlobalParams::probability_of_retransmission / GlobalParams::packet_injection_rate;
+    else
+	por_ratio = 1.0;
+
+    // -warmup and -sim give the length of each level
+    warm_up_cycles = GlobalParams::stats_warm_up_time;
+    measure_cycles = GlobalParams::simulation_time - GlobalParams::stats_warm_up_time;
+    // measure() overwrites simulation_time
+    drain_cycles = GlobalParams::simulation_time;
+    received_flits = 0;
+}
+
+double LoadSweep::now() const
+{
+    return sc_time_stamp().to_double() / GlobalParams::clock_period_ps - GlobalParams::reset_time;
+}
+
+bool LoadSweep::stopped() const
+{
+    return sc_get_status() == SC_STOPPED;
+}
+
+void LoadSweep::setInjectionRate(const double pir)
+{
+    GlobalParams::packet_injection_rate = pir;
+    GlobalParams::probability_of_retransmission = min(1.0, pir * por_ratio);
+}
+
+void LoadSweep::runFor(const double cycles)
+{
+    if (cycles > 0 && !stopped())
+	sc_start(cycles * GlobalParams::clock_period_ps, SC_PS);
+}
+
+LoadPoint LoadSweep::measure(const double pir)
+{
+    LoadPoint p;
+
+    setInjectionRate(pir);
+
+    // The network keeps the state reached at the previous (lower) load,
+    // so only a short transient to the new level has to be discarded
+    runFor(warm_up_cycles);
+
+    double start = now();
+    noc->resetStats(start);
+
+    vector<unsigned long> queued;
+    queued.push_back(noc->getQueuedPackets());
+    for (int i = 0; i < SWEEP_QUEUE_SAMPLES; i++)
+    {
+	runFor((double) measure_cycles / SWEEP_QUEUE_SAMPLES);
+	queued.push_back(noc->getQueuedPackets());
+    }
+
+    // GlobalStats computes throughput over [stats_warm_up_time, simulation_time]
+    GlobalParams::stats_warm_up_time = start;
+    GlobalParams::simulation_time = now();
+
+    GlobalStats gs(noc);
+    p.pir = pir;
+    p.offered = pir * (GlobalParams::min_packet_size + GlobalParams::max_packet_size) / 2.0;
+    p.throughput = gs.getThroughput();
+    p.avg_delay = gs.getAverageDelay();
+    p.max_delay = gs.getMaxDelay();
+    p.queued = queued.back();
+    p.saturated = RunLengthController::queuesGrowing(queued, n_sources) ||
+	noc->getSaturatedSources() > 0;
+    received_flits += gs.getReceivedFlits();
+
+    cout << "PIR " << pir << ": throughput " << p.throughput
+	 << ", average delay " << p.avg_delay
+	 << (p.saturated ? " (saturated)" : "") << endl;
+
+    return p;
+}
+
+void LoadSweep::drain()
+{
+    // Empty the source queues before measuring a lower load, otherwise the
+    // backlog accumulated in saturation would bias the next level
+    setInjectionRate(0);
+
+    double limit = now() + drain_cycles;
+    while (noc->getQueuedPackets() > 0 && now() < limit && !stopped())
+	runFor(warm_up_cycles > 0 ? warm_up_cycles : 100);
+
+    // Let the packets already in the network reach their destination
+    runFor(warm_up_cycles);
+}
+
+void LoadSweep::run()
+{
+    double lo = -1, hi = -1;
+
+    for (double pir = GlobalParams::sweep_pir_min;
+	 pir <= GlobalParams::sweep_pir_max + 1e-12 && !stopped();
+	 pir += GlobalParams::sweep_pir_step)
+    {
+	LoadPoint p = measure(pir);
+	curve.push_back(p);
+
+	if (p.saturated)
+	{
+	    hi = pir;
+	    break;
+	}
+	lo = pir;
+    }
+
+    // Bisection between the last stable and the first saturated level
+    if (lo >= 0 && hi >= 0)
+    {
+	for (int i = 0; i < GlobalParams::sweep_bisections && !stopped(); i++)
+	{
+	    drain();
+
+	    double mid = (lo + hi) / 2;
+	    LoadPoint p = measure(mid);
+	    curve.push_back(p);
+
+	    if (p.saturated)
+		hi = mid;
+	    else
+		lo = mid;
+	}
+    }
+}
+
+static bool byPir(const LoadPoint & a, const LoadPoint & b)
+{
+    return a.pir < b.pir;
+}
+
+void LoadSweep::showResults(std::ostream & out) const
+{
+    vector<LoadPoint> sorted = curve;
+    sort(sorted.begin(), sorted.end(), byPir);
+
+    out << endl << "% Load-latency curve" << endl;
+    out << "% pir\toffered\tthroughput\tavg_delay\tmax_delay\tqueued\tsaturated" << endl;
+    for (unsigned int i = 0; i < sorted.size(); i++)
+	out << sorted[i].pir << "\t" << sorted[i].offered << "\t"
+	    << sorted[i].throughput << "\t" << sorted[i].avg_delay << "\t"
+	    << sorted[i].max_delay << "\t" << sorted[i].queued << "\t"
+	    << sorted[i].saturated << endl;
+
+    // Saturation throughput: best accepted load among the stable levels,
+    // saturation PIR: lowest level at which the source queues diverge
+    double saturation_throughput = 0;
+    double saturation_pir = -1;
+    for (unsigned int i = 0; i < sorted.size(); i++)
+    {
+	if (!sorted[i].saturated)
+	    saturation_throughput = max(saturation_throughput, sorted[i].throughput);
+	else if (saturation_pir < 0)
+	    saturation_pir = sorted[i].pir;
+    }
+
+    if (saturation_pir < 0)
+	out << "% Saturation not reached up to PIR " << GlobalParams::sweep_pir_max << endl;
+    else
+	out << "% Saturation PIR: " << saturation_pir << endl;
+    out << "% Saturation throughput (flits/cycle/IP): " << saturation_throughput << endl;
+}
@@ -0,0 +1,70 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the load-latency sweep
+ */
+
+#ifndef __NOXIMLOADSWEEP_H__
+#define __NOXIMLOADSWEEP_H__
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// Number of source queue samples taken during the measurement of a level
+#define SWEEP_QUEUE_SAMPLES 10
+
+struct NoC;
+
+struct LoadPoint {
+    double pir;			// packet injection rate
+    double offered;		// offered load (flits/cycle/IP)
+    double throughput;		// accepted load (flits/cycle/IP)
+    double avg_delay;		// cycles
+    double max_delay;		// cycles
+    unsigned long queued;	// packets in the source queues at the end
+    bool saturated;
+};
+
+class LoadSweep {
+
+  public:
+
+    LoadSweep(NoC * _noc);
+
+    // Steps the injection rate from sweep_pir_min to sweep_pir_max until
+    // saturation, then bisects between the last stable and the first
+    // saturated level
+    void run();
+
+    void showResults(std::ostream & out) const;
+
+    // Flits received in all the measurement windows
+    unsigned long getReceivedFlits() const { return received_flits; }
+
+  private:
+
+    NoC *noc;
+    int n_sources;
+    double por_ratio;		// probability_of_retransmission / pir
+    int warm_up_cycles;		// per level
+    int measure_cycles;		// per level
+    int drain_cycles;		// maximum per drain, the -sim value
+    unsigned long received_flits;
+
+    vector<LoadPoint> curve;
+
+    double now() const;
+    bool stopped() const;
+    void setInjectionRate(const double pir);
+    void runFor(const double cycles);
+    LoadPoint measure(const double pir);
+    void drain();
+};
+
+#endif
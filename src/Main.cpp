@@ -13,6 +13,13 @@
 #include "GlobalStats.h"
 #include "DataStructs.h"
 #include "GlobalParams.h"
+#include "Profiler.h"
+#include "RunLengthController.h"
+#include "LoadSweep.h"
+#include "SampledRun.h"
+#include "AnalyticalModel.h"
+#include "Partition.h"
+#include "RunDigest.h"
 
 #include <csignal>
 
@@ -22,6 +29,64 @@ using namespace std;
 unsigned int drained_volume;
 NoC *n;
 
+// Advance the simulation by the given number of cycles. When profiling,
+// the run is split in chunks so that progress can be reported
+void runCycles(double cycles)
+{
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+    double target = now + cycles;
+    double total = GlobalParams::reset_time + GlobalParams::simulation_time;
+
+    while (now < target && sc_get_status() != SC_STOPPED)
+    {
+	double chunk = min((double)PROFILE_CHUNK_CYCLES, target - now);
+	sc_start(chunk * GlobalParams::clock_period_ps, SC_PS);
+	now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+	Profiler::progress(now, total);
+    }
+}
+
+// Run batch after batch until the adaptive controller is satisfied or the
+// cycle cap is reached
+void runAdaptive()
+{
+    RunLengthController controller(n);
+    double now = 0;
+
+    if (GlobalParams::profile_mode)
+	Profiler::beginPhase(PROF_PHASE_WARMUP);
+
+    while (now < GlobalParams::simulation_time && sc_get_status() != SC_STOPPED)
+    {
+	double batch = min((double)controller.getBatchCycles(), GlobalParams::simulation_time - now);
+	sc_start(batch * GlobalParams::clock_period_ps, SC_PS);
+	now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps - GlobalParams::reset_time;
+
+	if (GlobalParams::profile_mode)
+	    Profiler::progress(now + GlobalParams::reset_time,
+			       GlobalParams::reset_time + GlobalParams::simulation_time);
+
+	bool was_warmed_up = controller.isWarmedUp();
+	bool stop = controller.endBatch(now);
+
+	if (!was_warmed_up && controller.isWarmedUp())
+	{
+	    n->resetStats(controller.getWarmUpTime());
+	    if (GlobalParams::profile_mode)
+		Profiler::beginPhase(PROF_PHASE_MEASUREMENT);
+	}
+
+	if (stop)
+	    break;
+    }
+
+    // Final statistics refer to the window actually measured
+    GlobalParams::stats_warm_up_time = controller.getWarmUpTime();
+    GlobalParams::simulation_time = now;
+
+    controller.showReport(cout);
+}
+
 void signalHandler( int signum )
 {
     cout << "\b\b  " << endl;
@@ -51,6 +116,20 @@ int sc_main(int arg_num, char *arg_vet[])
 
     configure(arg_num, arg_vet);
 
+    // Each process only simulates its band of the network
+    if (GlobalParams::partitions > 1)
+	Partition::start();
+
+    Profiler::enabled = GlobalParams::profile_mode;
+    RunDigest::enabled = GlobalParams::digest_mode;
+    if (!GlobalParams::digest_trace_filename.empty() &&
+	!RunDigest::openTrace(GlobalParams::digest_trace_filename.c_str()))
+    {
+	cerr << "Error: cannot create " << GlobalParams::digest_trace_filename << endl;
+	exit(1);
+    }
+    if (GlobalParams::profile_mode)
+	Profiler::beginPhase(PROF_PHASE_ELABORATION);
 
     // Signals
     sc_clock clock("clock", GlobalParams::clock_period_ps, SC_PS);
@@ -62,6 +141,17 @@ int sc_main(int arg_num, char *arg_vet[])
     n->clock(clock);
     n->reset(reset);
 
+    // The model only needs the elaborated routers and traffic sources
+    if (GlobalParams::analytical_mode)
+    {
+	srand(GlobalParams::rnd_generator_seed);
+
+	AnalyticalModel model(n);
+	model.evaluate();
+	model.showResults(std::cout);
+	return 0;
+    }
+
     // Trace signals
     sc_trace_file *tf = NULL;
     if (GlobalParams::trace_mode) {
@@ -69,31 +159,20 @@ int sc_main(int arg_num, char *arg_vet[])
 	sc_trace(tf, reset, "reset");
 	sc_trace(tf, clock, "clock");
 
-	for (int i = 0; i < GlobalParams::mesh_dim_x; i++) {
-	    for (int j = 0; j < GlobalParams::mesh_dim_y; j++) {
-		char label[64];
-
-		sprintf(label, "req(%02d)(%02d).east", i, j);
-		sc_trace(tf, n->req[i][j].east, label);
-		sprintf(label, "req(%02d)(%02d).west", i, j);
-		sc_trace(tf, n->req[i][j].west, label);
-		sprintf(label, "req(%02d)(%02d).south", i, j);
-		sc_trace(tf, n->req[i][j].south, label);
-		sprintf(label, "req(%02d)(%02d).north", i, j);
-		sc_trace(tf, n->req[i][j].north, label);
-
-		sprintf(label, "ack(%02d)(%02d).east", i, j);
-		sc_trace(tf, n->ack[i][j].east, label);
-		sprintf(label, "ack(%02d)(%02d).west", i, j);
-		sc_trace(tf, n->ack[i][j].west, label);
-		sprintf(label, "ack(%02d)(%02d).south", i, j);
-		sc_trace(tf, n->ack[i][j].south, label);
-		sprintf(label, "ack(%02d)(%02d).north", i, j);
-		sc_trace(tf, n->ack[i][j].north, label);
-	    }
+	// One req/ack pair per link, labelled (src.port)->(dst.port)
+	for (unsigned int l = 0; l < n->topology.links.size(); l++) {
+	    const TopologyLink & link = n->topology.links[l];
+	    char label[64];
+
+	    sprintf(label, "req(%d.%d)->(%d.%d)", link.src, link.src_port, link.dst, link.dst_port);
+	    sc_trace(tf, n->link_channel[l]->read().req, label);
+	    sprintf(label, "ack(%d.%d)->(%d.%d)", link.src, link.src_port, link.dst, link.dst_port);
+	    sc_trace(tf, n->link_channel[l]->read().ack, label);
 	}
     }
     // Reset the chip and run the simulation
+    if (GlobalParams::profile_mode)
+	Profiler::beginPhase(PROF_PHASE_RESET);
     reset.write(1);
     cout << "Reset for " << (int)(GlobalParams::reset_time) << " cycles... ";
     srand(GlobalParams::rnd_generator_seed);
@@ -107,19 +186,91 @@ int sc_main(int arg_num, char *arg_vet[])
     cout << " Now running for " << GlobalParams:: simulation_time << " cycles..." << endl;
     // fix clock periods different from 1ns
     //sc_start(GlobalParams::simulation_time, SC_NS);
-    sc_start(GlobalParams::simulation_time * GlobalParams::clock_period_ps, SC_PS);
+    if (GlobalParams::sweep_pir_max > 0)
+    {
+	if (GlobalParams::profile_mode)
+	    Profiler::beginPhase(PROF_PHASE_MEASUREMENT);
+
+	LoadSweep sweep(n);
+	sweep.run();
+
+	if (GlobalParams::trace_mode) sc_close_vcd_trace_file(tf);
+	sweep.showResults(std::cout);
+
+	if (GlobalParams::profile_mode)
+	{
+	    Profiler::endPhase();
+	    Profiler::showReport(std::cout,
+				 sc_time_stamp().to_double() / GlobalParams::clock_period_ps,
+				 sweep.getReceivedFlits());
+	}
+	return 0;
+    }
+    else if (GlobalParams::sample_period > 0)
+    {
+	if (GlobalParams::profile_mode)
+	    Profiler::beginPhase(PROF_PHASE_MEASUREMENT);
+
+	SampledRun sampled(n);
+	sampled.run();
+
+	if (GlobalParams::trace_mode) sc_close_vcd_trace_file(tf);
+	sampled.showResults(std::cout);
+
+	if (GlobalParams::profile_mode)
+	{
+	    Profiler::endPhase();
+	    Profiler::showReport(std::cout,
+				 sc_time_stamp().to_double() / GlobalParams::clock_period_ps,
+				 sampled.getReceivedFlits());
+	}
+	return 0;
+    }
+    else if (GlobalParams::adaptive_precision > 0)
+	runAdaptive();
+    else if (GlobalParams::profile_mode)
+    {
+	Profiler::beginPhase(PROF_PHASE_WARMUP);
+	runCycles(GlobalParams::stats_warm_up_time);
+	Profiler::beginPhase(PROF_PHASE_MEASUREMENT);
+	runCycles(GlobalParams::simulation_time - GlobalParams::stats_warm_up_time);
+    }
+    else
+	sc_start(GlobalParams::simulation_time * GlobalParams::clock_period_ps, SC_PS);
 
 
     // Close the simulation
     if (GlobalParams::trace_mode) sc_close_vcd_trace_file(tf);
+    if (GlobalParams::partitions > 1)
+	Partition::finish(n);
+    if (!GlobalParams::injection_record_filename.empty() &&
+	!n->irecorder.save(GlobalParams::injection_record_filename.c_str()))
+    {
+	cerr << "Error: cannot write " << GlobalParams::injection_record_filename << endl;
+	exit(1);
+    }
     cout << "Noxim simulation completed.";
     cout << " (" << sc_time_stamp().to_double() / GlobalParams::clock_period_ps << " cycles executed)" << endl;
     cout << endl;
 //assert(false);
     // Show statistics
+    if (GlobalParams::profile_mode)
+	Profiler::beginPhase(PROF_PHASE_STATS);
     GlobalStats gs(n);
     gs.showStats(std::cout, GlobalParams::detailed);
 
+    bool digest_ok = true;
+    if (GlobalParams::digest_mode)
+	digest_ok = RunDigest::showResult(std::cout, GlobalParams::digest_golden);
+
+    if (GlobalParams::profile_mode)
+    {
+	Profiler::endPhase();
+	Profiler::showReport(std::cout,
+			     sc_time_stamp().to_double() / GlobalParams::clock_period_ps,
+			     gs.getReceivedFlits());
+    }
+
 
     if ((GlobalParams::max_volume_to_be_drained > 0) &&
 	(sc_time_stamp().to_double() / GlobalParams::clock_period_ps - GlobalParams::reset_time >=
@@ -142,5 +293,5 @@ int sc_main(int arg_num, char *arg_vet[])
 #ifdef DEADLOCK_AVOIDANCE
 	cout << "***** WARNING: DEADLOCK_AVOIDANCE ENABLED!" << endl;
 #endif
-    return 0;
+    return digest_ok ? 0 : 1;
 }
@@ -16,33 +16,18 @@
 #include "GlobalRoutingTable.h"
 #include "GlobalTrafficTable.h"
 #include "GlobalTrafficHardcoding.h"
+#include "GlobalTrafficDependency.h"
 #include "Hub.h"
 #include "Channel.h"
 #include "TokenRing.h"
+#include "TerminalMonitor.h"
+#include "Topology.h"
+#include "LinkChannel.h"
+#include "Partition.h"
+#include "InjectionRecorder.h"
 
 using namespace std;
 
-template <typename T>
-struct sc_signal_NSWE
-{
-    sc_signal<T> east;
-    sc_signal<T> west;
-    sc_signal<T> south;
-    sc_signal<T> north;
-};
-
-template <typename T>
-struct sc_signal_NSWEH
-{
-    sc_signal<T> east;
-    sc_signal<T> west;
-    sc_signal<T> south;
-    sc_signal<T> north;
-    sc_signal<T> to_hub;
-    sc_signal<T> from_hub;
-};
-
-
 SC_MODULE(NoC)
 {
     public: bool SwitchOnly; //true if the tile are switch only 
@@ -50,35 +35,35 @@ SC_MODULE(NoC)
     sc_in_clk clock;		// The input clock for the NoC
     sc_in < bool > reset;	// The reset signal for the NoC
 
-    // Signals mesh and switch bloc in delta topologies
-    sc_signal_NSWEH<bool> **req;
-    sc_signal_NSWEH<bool> **ack;
-    sc_signal_NSWEH<TBufferFullStatus> **buffer_full_status;
-    sc_signal_NSWEH<Flit> **flit;
-    sc_signal_NSWE<int> **free_slots;
-
-    // NoP
-    sc_signal_NSWE<NoP_data> **nop_data;
-
-    //signals for connecting Core2Hub (just to test wireless in Butterfly)
-    sc_signal<Flit> *flit_from_hub;
-    sc_signal<Flit> *flit_to_hub;
+    // Port-level graph the network is instantiated from
+    TopologyGraph topology;
 
-    sc_signal<bool> *req_from_hub;
-    sc_signal<bool> *req_to_hub;
+    // Channels of the links of the topology graph, link_channel[link].
+    // NULL if neither end is elaborated by this process (see
+    // Partition::elaborates)
+    LinkChannel **link_channel;
 
-    sc_signal<bool> *ack_from_hub;
-    sc_signal<bool> *ack_to_hub;
+    // Links between each node and its radio hub, indexed by node id
+    LinkChannel *to_hub;
+    LinkChannel *from_hub;
 
-    sc_signal<TBufferFullStatus> *buffer_full_status_from_hub;
-    sc_signal<TBufferFullStatus> *buffer_full_status_to_hub;
+    // Ports without a link are bound to these channels
+    LinkChannel idle_tx;
+    LinkChannel idle_rx;
 
-
-
-    // Matrix of tiles
+    // Matrix of tiles: t[x][y] in the mesh, t[stage][switch] in delta
+    // topologies, where the endpoints are core[id]
     Tile ***t;
     Tile ** core;
 
+    // All the tiles, indexed by node id. NULL if simulated by another
+    // process
+    Tile ** tile;
+
+    // Partitioned runs, rank 0: results of the tiles simulated by the
+    // other processes, indexed by node id (see Partition::finish)
+    TileResults ** remote_results;
+
     map<int, Hub*> hub;
     map<int, Channel*> channel;
 
@@ -88,35 +73,48 @@ SC_MODULE(NoC)
     GlobalRoutingTable grtable;
     GlobalTrafficTable gttable;
     GlobalTrafficHardcoding ghtable;
+    GlobalTrafficDependency gdtable;
+    WirelessRoutingTable wrtable;
+    InjectionRecorder irecorder;
 
 
     // Constructor
 
-    SC_CTOR(NoC) 
+    SC_CTOR(NoC) : idle_tx("idle_tx"), idle_rx("idle_rx")
     {
 
-
-	if (GlobalParams::topology == TOPOLOGY_MESH)
-	    // Build the Mesh
-	    buildMesh();
-	else if (GlobalParams::topology == TOPOLOGY_BUTTERFLY)
-        buildButterfly(); 
-	else if (GlobalParams::topology == TOPOLOGY_BASELINE)
-	    buildBaseline();
-	else if (GlobalParams::topology == TOPOLOGY_OMEGA)
-	    buildOmega();
+	if (GlobalParams::topology == TOPOLOGY_MESH ||
+	    GlobalParams::topology == TOPOLOGY_BUTTERFLY ||
+	    GlobalParams::topology == TOPOLOGY_BASELINE ||
+	    GlobalParams::topology == TOPOLOGY_OMEGA ||
+	    GlobalParams::topology == TOPOLOGY_NETLIST)
+	    buildTopology();
 	else {
 	    cerr << "ERROR: Topology " << GlobalParams::topology << " is not yet supported." << endl;
 	    exit(0);
-    }
+	}
+
+	// Boundary links are exchanged with the other processes once the
+	// clocked processes of the cycle have committed them
+	if (GlobalParams::partitions > 1)
+	{
+	    Partition::bind(this);
+	    SC_METHOD(exchangeBoundary);
+	    sensitive << clock.neg();
+	    dont_initialize();
+	}
+
 	GlobalParams::channel_selection = CHSEL_RANDOM;
 	// out of yaml configuration (experimental features)
 	//GlobalParams::channel_selection = CHSEL_FIRST_FREE;
 
+	// The monitor wakes up every MONITOR_CHECK_CYCLES cycles (see
+	// next_trigger in asciiMonitor) and redraws at wall-clock rate
+	monitor = NULL;
 	if (GlobalParams::ascii_monitor)
 	{
+	    monitor = new TerminalMonitor(this);
 	    SC_METHOD(asciiMonitor);
-	    sensitive << clock.pos();
 	}
 
     }
@@ -124,14 +122,32 @@ SC_MODULE(NoC)
     // Support methods
     Tile *searchNode(const int id) const;
 
+    // Results of a node, from its tile or from remote_results
+    Stats & nodeStats(const int id) const;
+    Power & nodePower(const int id) const;
+    unsigned long nodeRoutedFlits(const int id) const;
+    unsigned int nodeDrained(const int id) const;
+    SourceQueueSummary nodeSourceQueue(const int id) const;
+
+    // Restart statistics collection of every tile, discarding the
+    // cycles before warm_up_time
+    void resetStats(const double warm_up_time);
+
+    // Total number of packets waiting in the PE source queues
+    unsigned long getQueuedPackets() const;
+
+    // Number of PEs whose bounded source queue stays full
+    int getSaturatedSources() const;
+
   private:
 
-    void buildMesh();
-    void buildButterfly();
-    void buildBaseline();
-    void buildOmega();
     void buildCommon();
+    void buildTopology();
+    void createTile(const TopologyNode & node);
+    void bindLink(const TopologyLink & link, LinkChannel & channel);
     void asciiMonitor();
+    void exchangeBoundary();
+    TerminalMonitor *monitor;
     int * hub_connected_ports;
 };
 
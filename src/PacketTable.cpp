@@ -0,0 +1,43 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the table of the packets in flight
+ */
+
+#include "PacketTable.h"
+
+#include <cassert>
+
+vector<PacketInfo> PacketTable::info;
+vector<unsigned int> PacketTable::free_ids;
+
+unsigned int PacketTable::add(const double timestamp, const long trace_id)
+{
+    unsigned int packet_id;
+
+    if (free_ids.empty())
+    {
+	packet_id = info.size();
+	info.push_back(PacketInfo());
+    }
+    else
+    {
+	packet_id = free_ids.back();
+	free_ids.pop_back();
+    }
+
+    info[packet_id].timestamp = timestamp;
+    info[packet_id].trace_id = trace_id;
+
+    return packet_id;
+}
+
+void PacketTable::remove(const unsigned int packet_id)
+{
+    assert(packet_id < info.size());
+    free_ids.push_back(packet_id);
+}
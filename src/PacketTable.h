@@ -0,0 +1,56 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the table of the packets in flight
+ */
+
+#ifndef __NOXIMPACKETTABLE_H__
+#define __NOXIMPACKETTABLE_H__
+
+#include <vector>
+
+using namespace std;
+
+// Per-packet metadata, shared by all the flits of the packet
+struct PacketInfo {
+    double timestamp;		// SC timestamp at packet generation
+    long trace_id;		// packet of a dependency trace, -1 otherwise
+};
+
+// Side table of the packets injected in the network and not yet
+// delivered. Flits only carry the packet_id indexing this table, so that
+// the metadata is stored once per packet. Ids are recycled when the tail
+// flit is delivered, hence the table is as large as the maximum number of
+// packets in flight
+class PacketTable {
+
+  public:
+
+    // Registers a new packet, returns its id
+    static unsigned int add(const double timestamp, const long trace_id = -1);
+
+    // Releases the id of a delivered packet
+    static void remove(const unsigned int packet_id);
+
+    static inline double timestamp(const unsigned int packet_id) {
+	return info[packet_id].timestamp;
+    }
+
+    static inline long traceId(const unsigned int packet_id) {
+	return info[packet_id].trace_id;
+    }
+
+    // Number of packets in flight
+    static unsigned int size() { return info.size() - free_ids.size(); }
+
+  private:
+
+    static vector<PacketInfo> info;
+    static vector<unsigned int> free_ids;
+};
+
+#endif
@@ -0,0 +1,400 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the multi-process partitioning
+ */
+
+#include "Partition.h"
+#include "NoC.h"
+
+#include <csignal>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+int Partition::rank = 0;
+int Partition::n_rings = 0;
+BoundaryRing *Partition::rings = NULL;
+vector<BoundaryLink> Partition::boundary;
+vector<int> Partition::result_fd;
+vector<pid_t> Partition::processes;
+pid_t Partition::parent;
+
+void Partition::start()
+{
+    int n_partitions = GlobalParams::partitions;
+
+    // Each cut between two bands is crossed by a link per column and
+    // direction, and each link has a ring per side
+    n_rings = (n_partitions - 1) * GlobalParams::mesh_dim_x * 4;
+    if (n_rings > 0)
+    {
+	void *shm = mmap(NULL, n_rings * sizeof(BoundaryRing), PROT_READ | PROT_WRITE,
+			 MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shm == MAP_FAILED)
+	{
+	    cerr << "Error: cannot map the boundary rings of the partitions" << endl;
+	    exit(1);
+	}
+
+	rings = (BoundaryRing *) shm;
+	for (int i = 0; i < n_rings; i++)
+	{
+	    new (&rings[i]) BoundaryRing();
+	    rings[i].produced.store(0);
+	    rings[i].consumed.store(0);
+	}
+    }
+
+    // Output buffered so far must not be repeated by the children
+    cout.flush();
+    fflush(stdout);
+
+    parent = getpid();
+    for (int r = 1; r < n_partitions; r++)
+    {
+	int fd[2];
+	if (pipe(fd) != 0)
+	{
+	    cerr << "Error: cannot create the result pipe of partition " << r << endl;
+	    exit(1);
+	}
+
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+	    cerr << "Error: cannot start partition " << r << endl;
+	    exit(1);
+	}
+
+	if (pid == 0)
+	{
+	    rank = r;
+	    for (unsigned int i = 0; i < result_fd.size(); i++)
+		close(result_fd[i]);
+	    close(fd[0]);
+	    result_fd.assign(1, fd[1]);
+	    processes.clear();
+
+	    // Only rank 0 reports
+	    if (freopen("/dev/null", "w", stdout) == NULL)
+		cerr << "Warning: partition " << rank << " cannot discard its output" << endl;
+	    signal(SIGQUIT, SIG_IGN);
+	    break;
+	}
+
+	close(fd[1]);
+	result_fd.push_back(fd[0]);
+	processes.push_back(pid);
+    }
+
+    if (GlobalParams::partition_numa)
+	pin();
+}
+
+void Partition::pin()
+{
+    // Round robin of the ranks on the NUMA nodes of the machine
+    int n_nodes = 0;
+    for (;; n_nodes++)
+    {
+	ostringstream node_dir;
+	node_dir << "/sys/devices/system/node/node" << n_nodes;
+	if (access(node_dir.str().c_str(), F_OK) != 0)
+	    break;
+    }
+
+    if (n_nodes == 0)
+    {
+	cerr << "Warning: no NUMA nodes found, partition " << rank << " is not pinned" << endl;
+	return;
+    }
+
+    int node = rank % n_nodes;
+    ostringstream cpulist;
+    cpulist << "/sys/devices/system/node/node" << node << "/cpulist";
+
+    ifstream fin(cpulist.str().c_str());
+    string list;
+    getline(fin, list);
+
+    // e.g. "0-7,16-23"
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    istringstream iss(list);
+    string range;
+    while (getline(iss, range, ','))
+    {
+	int first, last;
+	int n = sscanf(range.c_str(), "%d-%d", &first, &last);
+	if (n < 1)
+	    continue;
+	if (n == 1)
+	    last = first;
+	for (int cpu = first; cpu <= last; cpu++)
+	    CPU_SET(cpu, &cpus);
+    }
+
+    if (CPU_COUNT(&cpus) == 0 || sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+	cerr << "Warning: cannot pin partition " << rank << " to NUMA node " << node << endl;
+}
+
+bool Partition::elaborates(const int node_id)
+{
+    return GlobalParams::partitions <= 1 || owns(node_id);
+}
+
+int Partition::owner(const int node_id)
+{
+    int y = node_id / GlobalParams::mesh_dim_x;
+
+    return y * GlobalParams::partitions / GlobalParams::mesh_dim_y;
+}
+
+char *Partition::newRandomState(const unsigned int stream)
+{
+    char *state = new char[PARTITION_RANDOM_STATE_BYTES];
+
+    // initstate() also selects the new state
+    char *previous = initstate(GlobalParams::rnd_generator_seed + stream, state, PARTITION_RANDOM_STATE_BYTES);
+    setstate(previous);
+
+    return state;
+}
+
+void Partition::bind(NoC * noc)
+{
+    const TopologyGraph & topology = noc->topology;
+    int n_boundary = 0;
+
+    // Every process enumerates the boundary links in the same order
+    for (unsigned int l = 0; l < topology.links.size(); l++)
+    {
+	const TopologyLink & link = topology.links[l];
+	int src_owner = owner(link.src);
+	int dst_owner = owner(link.dst);
+
+	if (src_owner == dst_owner)
+	    continue;
+
+	BoundaryRing *forward = &rings[2 * n_boundary];
+	BoundaryRing *backward = &rings[2 * n_boundary + 1];
+	n_boundary++;
+
+	if (src_owner != rank && dst_owner != rank)
+	    continue;
+
+	BoundaryLink bl;
+	bl.channel = noc->link_channel[l];
+	bl.tx_side = (src_owner == rank);
+	bl.peer = bl.tx_side ? dst_owner : src_owner;
+	bl.out = bl.tx_side ? forward : backward;
+	bl.in = bl.tx_side ? backward : forward;
+	bl.last_req = false;
+	boundary.push_back(bl);
+    }
+
+    assert(2 * n_boundary == n_rings);
+}
+
+bool Partition::await(unsigned int & spins, const int peer)
+{
+    if (++spins < PARTITION_SPIN_LIMIT)
+	return false;
+
+    spins = 0;
+    std::this_thread::yield();
+
+    // The other processes are only watched by rank 0, which exits if one
+    // of them dies. The others notice it as they are reparented. Exited
+    // processes are not reaped here, finish() collects them
+    if (rank != 0)
+	return getppid() != parent;
+
+    if (peer == 0)
+	return false;
+
+    siginfo_t info;
+    info.si_pid = 0;
+    return waitid(P_PID, processes[peer - 1], &info, WEXITED | WNOHANG | WNOWAIT) == 0 && info.si_pid != 0;
+}
+
+void Partition::lost()
+{
+    cerr << "Error: a partition process exited, partition " << rank << " stops" << endl;
+    exit(1);
+}
+
+void Partition::exchange(const bool in_reset)
+{
+    // Publish the fields driven locally
+    for (unsigned int i = 0; i < boundary.size(); i++)
+    {
+	BoundaryLink & bl = boundary[i];
+	BoundaryRing *ring = bl.out;
+	long n = ring->produced.load(std::memory_order_relaxed);
+
+	unsigned int spins = 0;
+	while (n - ring->consumed.load(std::memory_order_acquire) >= PARTITION_RING_SLOTS)
+	    if (await(spins, bl.peer) && n - ring->consumed.load(std::memory_order_acquire) >= PARTITION_RING_SLOTS)
+		lost();
+
+	BoundaryRecord & record = ring->slot[n % PARTITION_RING_SLOTS];
+	record.state = bl.channel->read();
+
+	if (bl.tx_side && record.state.req != bl.last_req)
+	{
+	    // A new flit: the packet leaves this process with its last flit
+	    const Flit & flit = record.state.flit;
+	    if (!in_reset)
+	    {
+		if (flit.flit_type == FLIT_TYPE_HEAD)
+		{
+		    record.packet.timestamp = PacketTable::timestamp(flit.packet_id);
+		    record.packet.trace_id = PacketTable::traceId(flit.packet_id);
+		}
+		if (flit.flit_type == FLIT_TYPE_TAIL || GlobalParams::packet_mode)
+		    PacketTable::remove(flit.packet_id);
+	    }
+	    bl.last_req = record.state.req;
+	}
+
+	ring->produced.store(n + 1, std::memory_order_release);
+    }
+
+    // Import the fields driven remotely in the same cycle
+    for (unsigned int i = 0; i < boundary.size(); i++)
+    {
+	BoundaryLink & bl = boundary[i];
+	BoundaryRing *ring = bl.in;
+	long n = ring->consumed.load(std::memory_order_relaxed);
+
+	// A peer exits only after filling its rings of the last cycle
+	unsigned int spins = 0;
+	while (ring->produced.load(std::memory_order_acquire) <= n)
+	    if (await(spins, bl.peer) && ring->produced.load(std::memory_order_acquire) <= n)
+		lost();
+
+	const BoundaryRecord & record = ring->slot[n % PARTITION_RING_SLOTS];
+
+	if (bl.tx_side)
+	    bl.channel->importRx(record.state);
+	else if (record.state.req != bl.last_req)
+	{
+	    Flit flit = record.state.flit;
+	    if (!in_reset)
+	    {
+		if (flit.flit_type == FLIT_TYPE_HEAD)
+		    bl.packet_ids[flit.packet_id] = PacketTable::add(record.packet.timestamp, record.packet.trace_id);
+
+		map<uint32_t, uint32_t>::iterator it = bl.packet_ids.find(flit.packet_id);
+		assert(it != bl.packet_ids.end());
+		flit.packet_id = it->second;
+
+		if (flit.flit_type == FLIT_TYPE_TAIL || GlobalParams::packet_mode)
+		    bl.packet_ids.erase(it);
+	    }
+	    bl.channel->importTx(flit, record.state.req);
+	    bl.last_req = record.state.req;
+	}
+
+	ring->consumed.store(n + 1, std::memory_order_release);
+    }
+}
+
+template <typename T> static inline void put(FILE * f, const T & x)
+{
+    fwrite(&x, sizeof(T), 1, f);
+}
+
+template <typename T> static inline bool get(FILE * f, T & x)
+{
+    return fread(&x, sizeof(T), 1, f) == 1;
+}
+
+void Partition::saveTile(FILE * f, Tile * tile)
+{
+    Router *r = tile->r;
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+
+    r->stats.save(f);
+
+    PowerBreakdown *breakdown[2] = { r->power.getDynamicPowerBreakDown(), r->power.getStaticPowerBreakDown() };
+    for (int b = 0; b < 2; b++)
+	for (int i = 0; i < breakdown[b]->size; i++)
+	    put(f, breakdown[b]->breakdown[i].value);
+
+    put(f, r->routed_flits);
+    put(f, r->local_drained);
+    put(f, tile->pe->getSourceQueueSummary(now));
+}
+
+TileResults *Partition::loadTile(FILE * f, const int id)
+{
+    TileResults *results = new TileResults;
+
+    results->stats.configure(id, GlobalParams::stats_warm_up_time);
+    bool ok = results->stats.load(f);
+
+    PowerBreakdown *breakdown[2] = { results->power.getDynamicPowerBreakDown(), results->power.getStaticPowerBreakDown() };
+    for (int b = 0; b < 2; b++)
+	for (int i = 0; i < breakdown[b]->size; i++)
+	    ok = ok && get(f, breakdown[b]->breakdown[i].value);
+
+    ok = ok && get(f, results->routed_flits);
+    ok = ok && get(f, results->local_drained);
+    ok = ok && get(f, results->source_queue);
+
+    if (!ok)
+    {
+	cerr << "Error: truncated results for tile " << id << endl;
+	exit(1);
+    }
+
+    return results;
+}
+
+void Partition::finish(NoC * noc)
+{
+    int n_nodes = noc->topology.nodes.size();
+
+    if (rank != 0)
+    {
+	FILE *f = fdopen(result_fd[0], "w");
+	for (int id = 0; id < n_nodes; id++)
+	    if (owns(id))
+	    {
+		put(f, id);
+		saveTile(f, noc->tile[id]);
+	    }
+	fclose(f);
+	exit(0);
+    }
+
+    for (unsigned int p = 0; p < processes.size(); p++)
+    {
+	FILE *f = fdopen(result_fd[p], "r");
+	int id;
+	while (get(f, id))
+	{
+	    assert(id >= 0 && id < n_nodes && owner(id) == (int) p + 1);
+	    noc->remote_results[id] = loadTile(f, id);
+	}
+	fclose(f);
+
+	int status;
+	if (waitpid(processes[p], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+	{
+	    cerr << "Error: partition " << p + 1 << " failed" << endl;
+	    exit(1);
+	}
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the multi-process partitioning
+ */
+
+#ifndef __NOXIMPARTITION_H__
+#define __NOXIMPARTITION_H__
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include <sys/types.h>
+
+#include "LinkChannel.h"
+#include "PacketTable.h"
+#include "Stats.h"
+#include "Power.h"
+#include "ProcessingElement.h"
+
+using namespace std;
+
+// Records of a boundary ring, i.e. cycles a process can run ahead of the
+// consumer of its boundary state
+#define PARTITION_RING_SLOTS 8
+// Busy-wait iterations on a ring before yielding the CPU
+#define PARTITION_SPIN_LIMIT 1000
+// Size of the per-router and per-PE rand() states
+#define PARTITION_RANDOM_STATE_BYTES 256
+
+struct NoC;
+struct Tile;
+
+// Fields of a boundary link committed by one side in a cycle. Packet ids
+// are local to each process, so the metadata travels with the head flits
+struct BoundaryRecord {
+    LinkState state;
+    PacketInfo packet;
+};
+
+// Results of a tile simulated by another process, i.e. what GlobalStats
+// reads from a tile, received by rank 0 at the end of the run
+struct TileResults {
+    Stats stats;
+    Power power;
+    unsigned long routed_flits;
+    unsigned int local_drained;
+    SourceQueueSummary source_queue;
+};
+
+// Single-producer single-consumer ring in memory shared by two processes
+struct BoundaryRing {
+    std::atomic<long> produced;
+    std::atomic<long> consumed;
+    BoundaryRecord slot[PARTITION_RING_SLOTS];
+};
+
+// A link crossing the boundary of the local partition
+struct BoundaryLink {
+    LinkChannel *channel;
+    bool tx_side;			// the transmitter is simulated locally
+    int peer;				// rank simulating the other side
+    BoundaryRing *out;			// fields driven locally
+    BoundaryRing *in;			// fields driven remotely
+    bool last_req;			// ABP level of the last flit exchanged
+    map<uint32_t, uint32_t> packet_ids;	// remote to local ids of the packets in transit
+};
+
+// Conservative parallel simulation of a mesh by several local processes,
+// each simulating a band of rows. Processes exchange the state of the
+// links crossing the bands on every negative clock edge, which is enough
+// as no link state written in a cycle is read before the next one (one
+// cycle of lookahead). Every process, rank 0 included, only elaborates
+// its band and the links crossing its border; at the end the others send
+// the results of their tiles to rank 0, which reports from those records.
+// Each router and PE draws from its own rand() stream, so a run gives the
+// same results with any number of partitions
+class Partition {
+
+  public:
+
+    static int rank;
+
+    // Forks the other processes. Called before elaboration
+    static void start();
+
+    // Band of mesh rows simulated by rank
+    static int owner(const int node_id);
+    static bool owns(const int node_id) { return owner(node_id) == rank; }
+
+    // Tiles instantiated by the local process, i.e. its band
+    static bool elaborates(const int node_id);
+
+    // Per-router and per-PE random streams
+    static char *newRandomState(const unsigned int stream);
+    static inline void selectRandomState(char *state) {
+	if (state != NULL)
+	    setstate(state);
+    }
+
+    // Maps the links crossing the local band on the shared rings
+    static void bind(NoC * noc);
+
+    // Publishes the boundary fields driven locally and imports the remote
+    // ones of the current cycle
+    static void exchange(const bool in_reset);
+
+    // The other processes send the results of their tiles to rank 0 and
+    // exit, rank 0 stores them in NoC::remote_results
+    static void finish(NoC * noc);
+
+  private:
+
+    static int n_rings;
+    static BoundaryRing *rings;
+    static vector<BoundaryLink> boundary;
+    static vector<int> result_fd;	// rank 0: read end per process, others: write end
+    static vector<pid_t> processes;	// rank 0 only
+    static pid_t parent;
+
+    static void pin();
+    // Waits on a ring of peer. Returns true if the process that should
+    // fill it has exited
+    static bool await(unsigned int & spins, const int peer);
+    static void lost();
+    static void saveTile(FILE * f, Tile * tile);
+    static TileResults *loadTile(FILE * f, const int id);
+};
+
+#endif
@@ -9,6 +9,21 @@
  */
 
 #include "ProcessingElement.h"
+#include "Profiler.h"
+#include "PacketTable.h"
+#include "Partition.h"
+#include "RunDigest.h"
+
+// Traffic distribution of the run, a compile time constant in builds with
+// a fixed traffic distribution
+static inline TrafficType trafficType()
+{
+#ifdef FIXED_TRAFFIC
+    return NOXIM_CAT(TRAFFIC_TYPE_, FIXED_TRAFFIC);
+#else
+    return GlobalParams::traffic_type;
+#endif
+}
 
 int ProcessingElement::randInt(int min, int max)
 {
@@ -18,64 +33,107 @@ int ProcessingElement::randInt(int min, int max)
 
 void ProcessingElement::rxProcess()
 {
+    PROFILE_SCOPE(PROF_PE);
+
     if (reset.read()) {
-	ack_rx.write(0);
+	link_rx->writeAck(0);
 	current_level_rx = 0;
     } else {
-	if (req_rx.read() == 1 - current_level_rx) {
-	    Flit flit_tmp = flit_rx.read();
+	if (link_rx->readReq() == 1 - current_level_rx) {
 	    current_level_rx = 1 - current_level_rx;	// Negate the old value for Alternating Bit Protocol (ABP)
 	}
-	ack_rx.write(current_level_rx);
+	link_rx->writeAck(current_level_rx);
     }
 }
 
 void ProcessingElement::txProcess()
 {
+    PROFILE_SCOPE(PROF_PE);
+    Partition::selectRandomState(random_state);
+
     if (reset.read()) {
-	req_tx.write(0);
+	link_tx->writeReq(0);
 	current_level_tx = 0;
 	transmittedAtPreviousCycle = false;
+	held_valid = false;
+	last_empty = last_blocked = 0;
+	tx_busy_until = 0;
+	resetQueueStats(GlobalParams::stats_warm_up_time);
     } else {
+	double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+
+	// A packet held by the RESAMPLE policy freezes the generation until
+	// it gets into the queue
+	if (held_valid)
+	    retryHeldPacket(now);
+	blocked = sourceStalled();
+
+    if (trafficType() == TRAFFIC_TYPE_DEPENDENCY) {
+		// Packets whose dependencies have been delivered
+		long id;
+		int dst, size;
+		bool any = false;
+		while (!sourceStalled() && traffic_dependency->nextReady(local_id, now, id, dst, size)) {
+			Packet packet;
+			int vc = randInt(0,GlobalParams::n_virtual_channels-1);
+			packet.make(local_id, dst, vc, now, size > 0 ? size : getRandomSize());
+			packet.trace_id = id;
+			enqueuePacket(packet);
+			any = true;
+		}
 
-    if(GlobalParams::traffic_distribution != TRAFFIC_HARDCODED) {
+		transmittedAtPreviousCycle = any;
+    } else if(trafficType() != TRAFFIC_TYPE_HARDCODED) {
 		Packet packet;
-		if (canShot(packet)) {
-			packet_queue.push(packet);
+		if (sourceStalled()) {
+			// generation suspended, the state of the distribution is kept
+		} else if (canShot(packet)) {
+			enqueuePacket(packet);
 			transmittedAtPreviousCycle = true;
 		} else {
 			transmittedAtPreviousCycle = false;
 		}
-    } else if(traffic_cycle < traffic_hardcoded->num_cycles()) {
-		double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
-		
+    } else {
+		// Only the packets of this PE, which are sorted by cycle: the ones
+		// held back by a stalled queue are injected as soon as possible.
+		// Recorded schedules also fix the size and VC of the packets
+		size_t count;
+		const HardcodedTraceEntry * own = traffic_hardcoded->trafficOf(local_id, count);
+		const HardcodedTraceShape * shape = traffic_hardcoded->shapesOf(local_id);
+
 		bool any = false;
-		for (HardcodedTrafficEntry const& expected_packet
-			   : traffic_hardcoded->traffic_at_cycle(traffic_cycle)) {
-			if(expected_packet.src == local_id) {
-		    	Packet packet;
-				int vc = randInt(0,GlobalParams::n_virtual_channels-1);
-				packet.make(local_id, expected_packet.dst, vc, now, getRandomSize());
-				packet_queue.push(packet);
-				any = true;
+		while (!sourceStalled() && traffic_next < count && own[traffic_next].cycle <= traffic_cycle) {
+			Packet packet;
+			if (shape != NULL)
+			    packet.make(local_id, own[traffic_next].dst, shape[traffic_next].vc, now, shape[traffic_next].size);
+			else {
+			    int vc = randInt(0,GlobalParams::n_virtual_channels-1);
+			    packet.make(local_id, own[traffic_next].dst, vc, now, getRandomSize());
 			}
+			enqueuePacket(packet);
+			traffic_next++;
+			any = true;
 		}
 
 		if(any)
 			transmittedAtPreviousCycle = true;
 		else
 			transmittedAtPreviousCycle = false;
-		
-		traffic_cycle += 1;
     }
+	traffic_cycle += 1;
 
+	updateQueueStats(now);
 
-	if (ack_tx.read() == current_level_tx) {
+	if (link_tx->readAck() == current_level_tx && now >= tx_busy_until) {
 	    if (!packet_queue.empty()) {
 		Flit flit = nextFlit();	// Generate a new flit
-		flit_tx->write(flit);	// Send the generated flit
 		current_level_tx = 1 - current_level_tx;	// Negate the old value for Alternating Bit Protocol (ABP)
-		req_tx.write(current_level_tx);
+		link_tx->writeFlit(flit, current_level_tx);	// Send the generated flit
+		RunDigest::inject((long) now, local_id, flit);
+
+		// In packet mode the link is busy with the body of the packet
+		if (GlobalParams::packet_mode)
+		    tx_busy_until = now + flit.sequence_length;
 	    }
 	}
     }
@@ -84,16 +142,23 @@ void ProcessingElement::txProcess()
 Flit ProcessingElement::nextFlit()
 {
     Flit flit;
-    Packet packet = packet_queue.front();
+    Packet & packet = packet_queue.front();
+
+    // Per-packet metadata is stored once, when the head flit is injected
+    if (packet.size == packet.flit_left)
+	packet.packet_id = PacketTable::add(packet.timestamp, packet.trace_id);
 
     flit.src_id = packet.src_id;
     flit.dst_id = packet.dst_id;
     flit.vc_id = packet.vc_id;
-    flit.timestamp = packet.timestamp;
+    flit.packet_id = packet.packet_id;
     flit.sequence_no = packet.size - packet.flit_left;
     flit.sequence_length = packet.size;
     flit.hop_no = 0;
-    //  flit.payload     = DEFAULT_PAYLOAD;
+    flit.use_low_voltage_path = packet.use_low_voltage_path;
+#ifdef FLIT_PAYLOAD
+    flit.payload.data = 0;
+#endif
 
     flit.hub_relay_node = NOT_VALID;
 
@@ -104,8 +169,12 @@ Flit ProcessingElement::nextFlit()
     else
 	flit.flit_type = FLIT_TYPE_BODY;
 
-    packet_queue.front().flit_left--;
-    if (packet_queue.front().flit_left == 0)
+    // In packet mode the head carries the whole packet
+    if (GlobalParams::packet_mode)
+	packet.flit_left = 1;
+
+    packet.flit_left--;
+    if (packet.flit_left == 0)
 	packet_queue.pop();
 
     return flit;
@@ -137,35 +206,15 @@ bool ProcessingElement::canShot(Packet & packet)
 
     double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
 
-    if (GlobalParams::traffic_distribution != TRAFFIC_TABLE_BASED) {
+    if (trafficType() != TRAFFIC_TYPE_TABLE_BASED) {
 	if (!transmittedAtPreviousCycle)
 	    threshold = GlobalParams::packet_injection_rate;
 	else
 	    threshold = GlobalParams::probability_of_retransmission;
 
 	shot = (((double) rand()) / RAND_MAX < threshold);
-	if (shot) {
-	    if (GlobalParams::traffic_distribution == TRAFFIC_RANDOM)
-		    packet = trafficRandom();
-        else if (GlobalParams::traffic_distribution == TRAFFIC_TRANSPOSE1)
-		    packet = trafficTranspose1();
-        else if (GlobalParams::traffic_distribution == TRAFFIC_TRANSPOSE2)
-    		packet = trafficTranspose2();
-        else if (GlobalParams::traffic_distribution == TRAFFIC_BIT_REVERSAL)
-		    packet = trafficBitReversal();
-        else if (GlobalParams::traffic_distribution == TRAFFIC_SHUFFLE)
-		    packet = trafficShuffle();
-        else if (GlobalParams::traffic_distribution == TRAFFIC_BUTTERFLY)
-		    packet = trafficButterfly();
-        else if (GlobalParams::traffic_distribution == TRAFFIC_LOCAL)
-		    packet = trafficLocal();
-        else if (GlobalParams::traffic_distribution == TRAFFIC_ULOCAL)
-		    packet = trafficULocal();
-        else {
-            cout << "Invalid traffic distribution: " << GlobalParams::traffic_distribution << endl;
-            exit(-1);
-        }
-	}
+	if (shot)
+	    packet = syntheticPacket();
     } else {			// Table based communication traffic
 	if (never_transmit)
 	    return false;
@@ -192,6 +241,32 @@ bool ProcessingElement::canShot(Packet & packet)
 }
 
 
+Packet ProcessingElement::syntheticPacket()
+{
+    switch (trafficType()) {
+    case TRAFFIC_TYPE_RANDOM:
+	return trafficRandom();
+    case TRAFFIC_TYPE_TRANSPOSE1:
+	return trafficTranspose1();
+    case TRAFFIC_TYPE_TRANSPOSE2:
+	return trafficTranspose2();
+    case TRAFFIC_TYPE_BIT_REVERSAL:
+	return trafficBitReversal();
+    case TRAFFIC_TYPE_SHUFFLE:
+	return trafficShuffle();
+    case TRAFFIC_TYPE_BUTTERFLY:
+	return trafficButterfly();
+    case TRAFFIC_TYPE_LOCAL:
+	return trafficLocal();
+    case TRAFFIC_TYPE_ULOCAL:
+	return trafficULocal();
+    default:
+	// rejected by checkConfiguration()
+	assert(false);
+	return Packet();
+    }
+}
+
 Packet ProcessingElement::trafficLocal()
 {
     Packet p;
@@ -228,7 +303,7 @@ Packet ProcessingElement::trafficLocal()
 
 int ProcessingElement::findRandomDestination(int id, int hops)
 {
-    assert(GlobalParams::topology == TOPOLOGY_MESH);
+    assert(GlobalParams::topology_type == TOPOLOGY_TYPE_MESH);
 
     int inc_y = rand()%2?-1:1;
     int inc_x = rand()%2?-1:1;
@@ -305,7 +380,7 @@ Packet ProcessingElement::trafficRandom()
     double range_start = 0.0;
     int max_id;
 
-    if (GlobalParams::topology == TOPOLOGY_MESH)
+    if (GlobalParams::topology_type == TOPOLOGY_TYPE_MESH)
 	max_id = (GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y) - 1; //Mesh 
     else    // other delta topologies
 	max_id = GlobalParams::n_delta_tiles-1; 
@@ -326,7 +401,7 @@ Packet ProcessingElement::trafficRandom()
 		range_start += GlobalParams::hotspots[i].second;	// try next
 	}
 #ifdef DEADLOCK_AVOIDANCE
-	assert((GlobalParams::topology == TOPOLOGY_MESH));
+	assert((GlobalParams::topology_type == TOPOLOGY_TYPE_MESH));
 	if (p.dst_id%2!=0)
 	{
 	    p.dst_id = (p.dst_id+1)%256;
@@ -357,7 +432,7 @@ Packet ProcessingElement::trafficTest()
 
 Packet ProcessingElement::trafficTranspose1()
 {
-    assert(GlobalParams::topology == TOPOLOGY_MESH);
+    assert(GlobalParams::topology_type == TOPOLOGY_TYPE_MESH);
     Packet p;
     p.src_id = local_id;
     Coord src, dst;
@@ -379,7 +454,7 @@ Packet ProcessingElement::trafficTranspose1()
 
 Packet ProcessingElement::trafficTranspose2()
 {
-    assert(GlobalParams::topology == TOPOLOGY_MESH);
+    assert(GlobalParams::topology_type == TOPOLOGY_TYPE_MESH);
     Packet p;
     p.src_id = local_id;
     Coord src, dst;
@@ -516,3 +591,161 @@ unsigned int ProcessingElement::getQueueSize() const
     return packet_queue.size();
 }
 
+
+bool ProcessingElement::sourceQueueFull() const
+{
+    return GlobalParams::source_queue_size > 0 &&
+	packet_queue.size() >= (unsigned int) GlobalParams::source_queue_size;
+}
+
+bool ProcessingElement::sourceStalled() const
+{
+    if (held_valid)
+	return true;
+
+    return GlobalParams::source_queue_policy_type == SOURCE_QUEUE_POLICY_STALL && sourceQueueFull();
+}
+
+void ProcessingElement::enqueuePacket(const Packet & packet)
+{
+    // The offered load, whatever happens to it
+    if (injection_recorder != NULL)
+	injection_recorder->record(local_id, traffic_cycle, packet);
+
+    if (!sourceQueueFull()) {
+	packet_queue.push(packet);
+	return;
+    }
+
+    // Only reached by DROP and RESAMPLE, STALL never generates into a
+    // full queue
+    blocked = true;
+    if (GlobalParams::source_queue_policy_type == SOURCE_QUEUE_POLICY_DROP) {
+	dropped_packets++;
+	dropped_flits += packet.size;
+    } else {
+	held_packet = packet;
+	held_valid = true;
+    }
+}
+
+void ProcessingElement::retryHeldPacket(const double now)
+{
+    if (sourceQueueFull())
+	return;
+
+    // Each cycle with room the packet enters with the injection
+    // probability, i.e. after a geometric delay. Its generation time is
+    // resampled to the cycle it enters the queue
+    double p = GlobalParams::packet_injection_rate > 0 ? GlobalParams::packet_injection_rate : 1.0;
+    if (((double) rand()) / RAND_MAX < p) {
+	held_packet.timestamp = now;
+	packet_queue.push(held_packet);
+	held_valid = false;
+    }
+}
+
+void ProcessingElement::updateQueueStats(const double now)
+{
+    if (packet_queue.empty())
+	last_empty = now;
+    if (blocked)
+	last_blocked = now;
+
+    if (now - GlobalParams::reset_time < queue_warm_up_time)
+	return;
+
+    queue_occupancy_sum += packet_queue.size();
+    queue_samples++;
+    if (packet_queue.size() > max_queue_size)
+	max_queue_size = packet_queue.size();
+    if (blocked)
+	blocked_cycles++;
+}
+
+void ProcessingElement::resetQueueStats(const double warm_up_time)
+{
+    queue_warm_up_time = warm_up_time;
+    queue_occupancy_sum = 0.0;
+    queue_samples = 0;
+    max_queue_size = 0;
+    blocked_cycles = 0;
+    dropped_packets = 0;
+    dropped_flits = 0;
+}
+
+bool ProcessingElement::isSaturated(const double now) const
+{
+    // Below saturation a queue drains from time to time, above it the
+    // queue stays full and keeps blocking the generation
+    return last_blocked > last_empty &&
+	now - last_empty >= SOURCE_QUEUE_SATURATION_CYCLES;
+}
+
+double ProcessingElement::getAverageQueueSize() const
+{
+    return queue_samples > 0 ? queue_occupancy_sum / queue_samples : 0.0;
+}
+
+SourceQueueSummary ProcessingElement::getSourceQueueSummary(const double now) const
+{
+    SourceQueueSummary summary;
+
+    summary.average_size = getAverageQueueSize();
+    summary.max_size = max_queue_size;
+    summary.blocked_cycles = blocked_cycles;
+    summary.dropped_packets = dropped_packets;
+    summary.dropped_flits = dropped_flits;
+    summary.size = getQueueSize();
+    summary.saturated = isSaturated(now);
+
+    return summary;
+}
+
+double ProcessingElement::injectionRate() const
+{
+    // Stationary probability of the two-state (pir, por) process
+    double pir = GlobalParams::packet_injection_rate;
+    double por = GlobalParams::probability_of_retransmission;
+
+    return (1 + pir - por) > 0 ? pir / (1 + pir - por) : 0;
+}
+
+void ProcessingElement::fastForward(const long cycles, FunctionalNetwork & network)
+{
+    if (trafficType() == TRAFFIC_TYPE_HARDCODED) {
+	// The packets of the skipped cycles
+	size_t count;
+	const HardcodedTraceEntry * own = traffic_hardcoded->trafficOf(local_id, count);
+
+	traffic_cycle += cycles;
+	const HardcodedTraceShape * shape = traffic_hardcoded->shapesOf(local_id);
+	while (traffic_next < count && own[traffic_next].cycle < traffic_cycle) {
+	    network.deliver(local_id, own[traffic_next].dst, shape != NULL ? shape[traffic_next].size : getRandomSize());
+	    traffic_next++;
+	}
+	return;
+    }
+
+    // Synthetic traffic, injecting at the stationary rate after geometric
+    // gaps
+    if (never_transmit)
+	return;
+
+    double rate = injectionRate();
+    if (rate <= 0)
+	return;
+
+    for (long t = 0;;) {
+	if (rate < 1) {
+	    double u = (rand() + 1.0) / (RAND_MAX + 1.0);
+	    t += 1 + (long) (log(u) / log(1 - rate));
+	} else
+	    t++;
+	if (t > cycles)
+	    break;
+
+	Packet packet = syntheticPacket();
+	network.deliver(local_id, packet.dst_id, packet.size);
+    }
+}
@@ -15,12 +15,31 @@
 #include <systemc.h>
 
 #include "DataStructs.h"
+#include "LinkChannel.h"
 #include "GlobalTrafficTable.h"
 #include "GlobalTrafficHardcoding.h"
+#include "GlobalTrafficDependency.h"
+#include "InjectionRecorder.h"
+#include "FunctionalNetwork.h"
 #include "Utils.h"
 
 using namespace std;
 
+// A bounded source queue that blocked generation and has not been empty
+// for this number of cycles flags its PE as saturated
+#define SOURCE_QUEUE_SATURATION_CYCLES 1000
+
+// Source queue statistics of a PE, as reported by GlobalStats
+struct SourceQueueSummary {
+    double average_size;	// packets
+    unsigned int max_size;
+    unsigned long blocked_cycles;
+    unsigned long dropped_packets;
+    unsigned long dropped_flits;
+    unsigned int size;		// packets queued now
+    bool saturated;
+};
+
 SC_MODULE(ProcessingElement)
 {
 
@@ -28,17 +47,8 @@ SC_MODULE(ProcessingElement)
     sc_in_clk clock;		// The input clock for the PE
     sc_in < bool > reset;	// The reset signal for the PE
 
-    sc_in < Flit > flit_rx;	// The input channel
-    sc_in < bool > req_rx;	// The request associated with the input channel
-    sc_out < bool > ack_rx;	// The outgoing ack signal associated with the input channel
-    sc_out < TBufferFullStatus > buffer_full_status_rx;	
-
-    sc_out < Flit > flit_tx;	// The output channel
-    sc_out < bool > req_tx;	// The request associated with the output channel
-    sc_in < bool > ack_tx;	// The outgoing ack signal associated with the output channel
-    sc_in < TBufferFullStatus > buffer_full_status_tx;
-
-    sc_in < int >free_slots_neighbor;
+    sc_port < LinkRxIf > link_rx;	// The input link from the router
+    sc_port < LinkTxIf > link_tx;	// The output link to the router
 
     // Registers
     int local_id;		// Unique identification number
@@ -46,12 +56,31 @@ SC_MODULE(ProcessingElement)
     bool current_level_tx;	// Current level for Alternating Bit Protocol (ABP)
     queue < Packet > packet_queue;	// Local queue of packets
     bool transmittedAtPreviousCycle;	// Used for distributions with memory
+    double tx_busy_until;	// packet mode: cycle at which the link is free again
+    char *random_state;		// Own rand() stream of partitioned runs
+
+    // Source queue bounded by GlobalParams::source_queue_size
+    Packet held_packet;		// packet retried under the RESAMPLE policy
+    bool held_valid;
+    bool blocked;		// generation blocked by the full queue in this cycle
+    double last_empty;		// last cycle the queue was empty
+    double last_blocked;	// last cycle generation was blocked
+
+    // Source queue statistics, collected after queue_warm_up_time
+    double queue_warm_up_time;
+    double queue_occupancy_sum;	// sum of the queue sizes of each cycle
+    unsigned long queue_samples;	// cycles summed in queue_occupancy_sum
+    unsigned int max_queue_size;
+    unsigned long blocked_cycles;
+    unsigned long dropped_packets;	// lost under the DROP policy
+    unsigned long dropped_flits;
 
     // Functions
     void rxProcess();		// The receiving process
     void txProcess();		// The transmitting process
     bool canShot(Packet & packet);	// True when the packet must be shot
     Flit nextFlit();	// Take the next flit of the current packet
+    Packet syntheticPacket();	// Packet of the synthetic traffic distribution
     Packet trafficTest();	// used for testing traffic
     Packet trafficRandom();	// Random destination distribution
     Packet trafficTranspose1();	// Transpose 1 destination distribution
@@ -62,9 +91,12 @@ SC_MODULE(ProcessingElement)
     Packet trafficLocal();	// Random with locality
     Packet trafficULocal();	// Random with locality
 
-    size_t traffic_cycle = 0;
+    size_t traffic_cycle = 0;	// cycles since the end of the reset
+    size_t traffic_next = 0;	// next of the hardcoded packets of the PE
     GlobalTrafficTable *traffic_table;	// Reference to the Global traffic Table
     GlobalTrafficHardcoding *traffic_hardcoded;	// Reference to the Global traffic Hardcoding
+    GlobalTrafficDependency *traffic_dependency;	// Reference to the dependency trace
+    InjectionRecorder *injection_recorder;	// NULL unless -record_injection
     bool never_transmit;	// true if the PE does not transmit any packet 
     //  (valid only for the table based traffic)
 
@@ -79,8 +111,29 @@ SC_MODULE(ProcessingElement)
     int findRandomDestination(int local_id,int hops);
     unsigned int getQueueSize() const;
 
+    bool sourceQueueFull() const;
+    bool sourceStalled() const;		// true when generation must not run
+    void enqueuePacket(const Packet & packet);	// applies the source queue policy
+    void retryHeldPacket(const double now);
+    void updateQueueStats(const double now);
+    void resetQueueStats(const double warm_up_time);
+    bool isSaturated(const double now) const;	// see SOURCE_QUEUE_SATURATION_CYCLES
+    double getAverageQueueSize() const;
+    SourceQueueSummary getSourceQueueSummary(const double now) const;
+
+    // Long-run packets per cycle of the synthetic traffic
+    double injectionRate() const;
+
+    // Fast-forward of sampled runs: the packets this PE would generate in
+    // the next cycles are delivered by the functional network instead of
+    // being simulated. Queued packets are left where they are
+    void fastForward(const long cycles, FunctionalNetwork & network);
+
     // Constructor
     SC_CTOR(ProcessingElement) {
+	random_state = NULL;
+	injection_recorder = NULL;
+
 	SC_METHOD(rxProcess);
 	sensitive << reset;
 	sensitive << clock.pos();
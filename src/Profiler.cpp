@@ -0,0 +1,145 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the simulator self-profiler
+ */
+
+#include "Profiler.h"
+
+#include <iomanip>
+#include <sys/resource.h>
+
+bool Profiler::enabled = false;
+
+Profiler::Clock::time_point Profiler::start;
+Profiler::Clock::time_point Profiler::phase_start;
+Profiler::Clock::time_point Profiler::last_progress;
+int Profiler::current_phase = -1;
+Profiler::Clock::duration Profiler::phase_time[PROF_PHASES];
+
+int Profiler::current_component = -1;
+Profiler::Clock::time_point Profiler::mark;
+Profiler::Clock::duration Profiler::component_time[PROF_COMPONENTS];
+unsigned long Profiler::component_calls[PROF_COMPONENTS];
+
+static const char *phase_names[PROF_PHASES] = {
+    "elaboration", "reset", "warm-up", "measurement", "stats"
+};
+
+static const char *component_names[PROF_COMPONENTS] = {
+    "router rx", "router tx", "processing element", "hub", "token ring", "stats"
+};
+
+static inline double seconds(const Profiler::Clock::duration & d)
+{
+    return std::chrono::duration<double>(d).count();
+}
+
+static void showRow(std::ostream & out, const char *name, const double t, const double total)
+{
+    std::ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+
+    out << "%   " << setw(20) << left << name << right << setw(12) << t
+	<< setw(8) << fixed << setprecision(1) << (total > 0 ? 100.0 * t / total : 0) << "%";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Profiler::beginPhase(const ProfilePhase phase)
+{
+    Clock::time_point now = Clock::now();
+
+    if (current_phase < 0)
+	start = last_progress = now;
+    else
+	phase_time[current_phase] += now - phase_start;
+
+    current_phase = phase;
+    phase_start = now;
+}
+
+void Profiler::endPhase()
+{
+    if (current_phase < 0)
+	return;
+
+    phase_time[current_phase] += Clock::now() - phase_start;
+    current_phase = -1;
+}
+
+void Profiler::progress(const double current_cycle, const double total_cycles)
+{
+    Clock::time_point now = Clock::now();
+
+    if (seconds(now - last_progress) < PROFILE_PROGRESS_INTERVAL)
+	return;
+    last_progress = now;
+
+    // Rate measured from the beginning of the reset phase
+    double elapsed = seconds(now - start - phase_time[PROF_PHASE_ELABORATION]);
+    double rate = (elapsed > 0) ? current_cycle / elapsed : 0;
+    double eta = (rate > 0) ? (total_cycles - current_cycle) / rate : 0;
+
+    std::ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+
+    cout << "[profile] cycle " << (long)current_cycle << "/" << (long)total_cycles
+	 << " (" << fixed << setprecision(1) << 100.0 * current_cycle / total_cycles << "%), "
+	 << setprecision(0) << rate << " cycles/s, ETA " << eta << "s" << endl;
+    cout.flags(flags);
+    cout.precision(precision);
+}
+
+long Profiler::getPeakRSS()
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+	return -1;
+
+    // ru_maxrss is expressed in kilobytes on Linux
+    return usage.ru_maxrss;
+}
+
+void Profiler::showReport(std::ostream & out, const double cycles, const unsigned long flits)
+{
+    double wall = seconds(Clock::now() - start);
+    double running = seconds(phase_time[PROF_PHASE_RESET] +
+			     phase_time[PROF_PHASE_WARMUP] +
+			     phase_time[PROF_PHASE_MEASUREMENT]);
+    double measurement = seconds(phase_time[PROF_PHASE_MEASUREMENT]);
+
+    out << endl << "% Profiling report" << endl;
+    out << "% Wall time (s): " << wall << endl;
+    out << "% Simulated cycles per second: " << (running > 0 ? cycles / running : 0) << endl;
+    out << "% Delivered flits per second: " << (measurement > 0 ? flits / measurement : 0) << endl;
+    out << "% Peak RSS (KB): " << getPeakRSS() << endl;
+
+    out << "% Time per phase (s):" << endl;
+    for (int i = 0; i < PROF_PHASES; i++)
+    {
+	showRow(out, phase_names[i], seconds(phase_time[i]), wall);
+	out << endl;
+    }
+
+    // Whatever is not spent inside a timed process belongs to the kernel
+    // (scheduler, signal updates) and to untimed modules
+    Clock::duration accounted = Clock::duration::zero();
+    for (int i = 0; i < PROF_COMPONENTS; i++)
+	accounted += component_time[i];
+
+    out << "% Time per component (s):" << endl;
+    for (int i = 0; i < PROF_COMPONENTS; i++)
+    {
+	showRow(out, component_names[i], seconds(component_time[i]), running);
+	out << "  (" << component_calls[i] << " calls)" << endl;
+    }
+    showRow(out, "kernel/other", running - seconds(accounted), running);
+    out << endl;
+}
@@ -0,0 +1,123 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the simulator self-profiler
+ */
+
+#ifndef __NOXIMPROFILER_H__
+#define __NOXIMPROFILER_H__
+
+#include <iostream>
+#include <chrono>
+
+using namespace std;
+
+// Minimum wall time between two progress reports [s]
+#define PROFILE_PROGRESS_INTERVAL 5.0
+// Granularity of the simulation steps used to check progress [cycles]
+#define PROFILE_CHUNK_CYCLES 1000
+
+// Simulation phases
+enum ProfilePhase {
+    PROF_PHASE_ELABORATION,
+    PROF_PHASE_RESET,
+    PROF_PHASE_WARMUP,
+    PROF_PHASE_MEASUREMENT,
+    PROF_PHASE_STATS,
+    PROF_PHASES
+};
+
+// Component classes whose processes are timed
+enum ProfileComponent {
+    PROF_ROUTER_RX,
+    PROF_ROUTER_TX,
+    PROF_PE,
+    PROF_HUB,
+    PROF_TOKEN_RING,
+    PROF_STATS,
+    PROF_COMPONENTS
+};
+
+class Profiler {
+
+  public:
+
+    typedef std::chrono::steady_clock Clock;
+
+    static bool enabled;
+
+    // Phase accounting (wall time between two consecutive calls)
+    static void beginPhase(const ProfilePhase phase);
+    static void endPhase();
+
+    // Periodic progress report (printed at most once every
+    // PROFILE_PROGRESS_INTERVAL seconds of wall time)
+    static void progress(const double current_cycle, const double total_cycles);
+
+    static void showReport(std::ostream & out, const double cycles, const unsigned long flits);
+
+    // Peak resident set size [KB]
+    static long getPeakRSS();
+
+    // Exclusive time attribution: a nested scope pauses the enclosing
+    // one so that, e.g., stats collection is not counted as router tx
+    static inline void enter(const int component, int & previous) {
+	Clock::time_point now = Clock::now();
+	if (current_component >= 0)
+	    component_time[current_component] += now - mark;
+	previous = current_component;
+	current_component = component;
+	mark = now;
+    }
+
+    static inline void leave(const int previous) {
+	Clock::time_point now = Clock::now();
+	component_time[current_component] += now - mark;
+	component_calls[current_component]++;
+	current_component = previous;
+	mark = now;
+    }
+
+  private:
+
+    static Clock::time_point start;
+    static Clock::time_point phase_start;
+    static Clock::time_point last_progress;
+    static int current_phase;
+    static Clock::duration phase_time[PROF_PHASES];
+
+    static int current_component;
+    static Clock::time_point mark;
+    static Clock::duration component_time[PROF_COMPONENTS];
+    static unsigned long component_calls[PROF_COMPONENTS];
+};
+
+// Times the enclosing block when profiling is enabled
+class ProfileScope {
+
+  public:
+
+    ProfileScope(const int component) {
+	active = Profiler::enabled;
+	if (active)
+	    Profiler::enter(component, previous);
+    }
+
+    ~ProfileScope() {
+	if (active)
+	    Profiler::leave(previous);
+    }
+
+  private:
+
+    bool active;
+    int previous;
+};
+
+#define PROFILE_SCOPE(c) ProfileScope profile_scope_(c)
+
+#endif
@@ -12,12 +12,14 @@
 
 ReservationTable::ReservationTable()
 {
+    reserved_mask = 0;
 }
 
 void ReservationTable::setSize(const int n_outputs)
 {
     this->n_outputs = n_outputs;
     rtable = new TRTEntry[this->n_outputs];
+    reserved_mask = 0;
 
     for (int i=0;i<this->n_outputs;i++)
     {
@@ -112,6 +114,8 @@ void ReservationTable::reserve(const TReservation r, const int port_out)
     // from the current index
     rtable[port_out].reservations.push_back(r);
 
+    if (port_out < RT_MASK_BITS)
+	reserved_mask |= 1u << port_out;
 }
 
 void ReservationTable::release(const TReservation r, const int port_out)
@@ -132,6 +136,9 @@ void ReservationTable::release(const TReservation r, const int port_out)
 		if (rtable[port_out].index >= rtable[port_out].reservations.size())
 		    rtable[port_out].index = 0;
 
+	    if (rtable[port_out].reservations.empty() && port_out < RT_MASK_BITS)
+		reserved_mask &= ~(1u << port_out);
+
 	    return;
 	}
     }
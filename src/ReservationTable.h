@@ -17,6 +17,8 @@
 
 using namespace std;
 
+#define RT_MASK_BITS 32
+
 
 struct TReservation
 {
@@ -60,6 +62,10 @@ class ReservationTable {
     // check whether port_out has no reservations
     bool isNotReserved(const int port_out);
 
+    // Bit o set if output o has no reservations (only the first
+    // RT_MASK_BITS outputs are tracked)
+    inline unsigned int notReservedMask() const { return ~reserved_mask; }
+
     void setSize(const int n_outputs);
 
     void print();
@@ -70,6 +76,8 @@ class ReservationTable {
 			// which reserved output port
 
      int n_outputs;
+
+     unsigned int reserved_mask;	// bit o set if output o has reservations
 };
 
 #endif
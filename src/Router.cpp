@@ -9,284 +9,412 @@
  */
 
 #include "Router.h"
+#include "Profiler.h"
+#include "PacketTable.h"
+#include "Partition.h"
+#include "RunDigest.h"
+
+// Builds with a fixed routing algorithm or selection strategy call it
+// through a qualified, hence non-virtual, member function call
+#ifdef FIXED_ROUTING
+#define FIXED_ROUTING_CLASS NOXIM_CAT(Routing_, FIXED_ROUTING)
+#include NOXIM_STR(routingAlgorithms/FIXED_ROUTING_CLASS.h)
+static FIXED_ROUTING_CLASS * const fixed_routing = FIXED_ROUTING_CLASS::getInstance();
+#endif
+#ifdef FIXED_SELECTION
+#define FIXED_SELECTION_CLASS NOXIM_CAT(Selection_, FIXED_SELECTION)
+#include NOXIM_STR(selectionStrategies/FIXED_SELECTION_CLASS.h)
+static FIXED_SELECTION_CLASS * const fixed_selection = FIXED_SELECTION_CLASS::getInstance();
+#endif
 
 
-inline int toggleKthBit(int n, int k)
-{
-	return (n ^ (1 << (k-1)));
-}
-
 void Router::process()
 {
+    Partition::selectRandomState(random_state);
     txProcess();
     rxProcess();
 }
 
+// Number of VCs and VC index wrap-around for the specialisations of the
+// rx/tx cycles: N_VC is a power of two, or 0 for any runtime value
+template <int N_VC>
+static inline int numVCs()
+{
+    return N_VC ? N_VC : GlobalParams::n_virtual_channels;
+}
+
+template <int N_VC>
+static inline int wrapVC(const int vc)
+{
+    return N_VC ? (vc & (N_VC - 1)) : (vc % GlobalParams::n_virtual_channels);
+}
+
+template <int N_VC>
+void Router::bindCycles()
+{
+    // Without winoc nothing ever crosses the hub port
+    if (GlobalParams::use_winoc)
+    {
+	rx_cycle = &Router::rxCycle<N_VC, DIRECTIONS + 2>;
+	tx_cycle = &Router::txCycle<N_VC, DIRECTIONS + 2>;
+    }
+    else
+    {
+	rx_cycle = &Router::rxCycle<N_VC, DIRECTIONS + 1>;
+	tx_cycle = &Router::txCycle<N_VC, DIRECTIONS + 1>;
+    }
+}
+
+void Router::selectCycles()
+{
+    // Generic fallback (N_VC = 0) for the other VC counts
+    switch (GlobalParams::n_virtual_channels)
+    {
+    case 1: bindCycles<1>(); break;
+    case 2: bindCycles<2>(); break;
+    case 4: bindCycles<4>(); break;
+    default: bindCycles<0>(); break;
+    }
+}
+
 void Router::rxProcess()
 {
+    PROFILE_SCOPE(PROF_ROUTER_RX);
+
     if (reset.read()) {
-	TBufferFullStatus bfs;
 	// Clear outputs and indexes of receiving protocol
 	for (int i = 0; i < DIRECTIONS + 2; i++) {
-	    ack_rx[i].write(0);
+	    link_rx[i]->writeAck(0);
 	    current_level_rx[i] = 0;
-	    buffer_full_status_rx[i].write(bfs);
+	    buffer_full_status[i] = TBufferFullStatus();
+	    link_rx[i]->writeBufferFullStatus(buffer_full_status[i]);
 	}
 	routed_flits = 0;
 	local_drained = 0;
     } 
     else 
-    { 
-	// This process simply sees a flow of incoming flits. All arbitration
-	// and wormhole related issues are addressed in the txProcess()
-	//assert(false);
-	for (int i = 0; i < DIRECTIONS + 2; i++) {
-	    // To accept a new flit, the following conditions must match:
-	    // 1) there is an incoming request
-	    // 2) there is a free slot in the input buffer of direction i
-	    //LOG<<"****RX****DIRECTION ="<<i<<  endl;
-
-	    if (req_rx[i].read() == 1 - current_level_rx[i])
-	    { 
-		Flit received_flit = flit_rx[i].read();
-		//LOG<<"request opposite to the current_level, reading flit "<<received_flit<<endl;
-
-		int vc = received_flit.vc_id;
+	(this->*rx_cycle)();
+}
 
-		if (!buffer[i][vc].IsFull()) 
-		{
+template <int N_VC, int N_PORTS>
+void Router::rxCycle()
+{
+    // This process simply sees a flow of incoming flits. All arbitration
+    // and wormhole related issues are addressed in the txProcess()
+    //assert(false);
+    for (int i = 0; i < N_PORTS; i++) {
+	// To accept a new flit, the following conditions must match:
+	// 1) there is an incoming request
+	// 2) there is a free slot in the input buffer of direction i
+	//LOG<<"****RX****DIRECTION ="<<i<<  endl;
+
+	if (link_rx[i]->readReq() == 1 - current_level_rx[i])
+	{ 
+	    Flit received_flit = link_rx[i]->readFlit();
+	    //LOG<<"request opposite to the current_level, reading flit "<<received_flit<<endl;
+
+	    int vc = received_flit.vc_id;
+
+	    if (!buffer[i][vc].IsFull()) 
+	    {
 
-		    // Store the incoming flit in the circular buffer
-		    buffer[i][vc].Push(received_flit);
-		    LOG << " Flit " << received_flit << " collected from Input[" << i << "][" << vc <<"]" << endl;
+		// Store the incoming flit in the circular buffer
+		buffer[i][vc].Push(received_flit);
+		if (buffer[i][vc].IsFull())
+		    buffer_full_status[i].setFull(vc);
+		LOG << " Flit " << received_flit << " collected from Input[" << i << "][" << vc <<"]" << endl;
 
+		if (GlobalParams::packet_mode)
+		    for (int f = 0; f < received_flit.sequence_length; f++)
+			power.bufferRouterPush();
+		else
 		    power.bufferRouterPush();
 
-		    // Negate the old value for Alternating Bit Protocol (ABP)
-		    //LOG<<"INVERTING CL FROM "<< current_level_rx[i]<< " TO "<<  1 - current_level_rx[i]<<endl;
-		    current_level_rx[i] = 1 - current_level_rx[i];
-
-		    // if a new flit is injected from local PE
-		    if (received_flit.src_id == local_id)
-			power.networkInterface();
-		}
+		// Negate the old value for Alternating Bit Protocol (ABP)
+		//LOG<<"INVERTING CL FROM "<< current_level_rx[i]<< " TO "<<  1 - current_level_rx[i]<<endl;
+		current_level_rx[i] = 1 - current_level_rx[i];
 
-		else  // buffer full
-		{
-		    // should not happen with the new TBufferFullStatus control signals    
-		    // except for flit coming from local PE, which don't use it 
-		    LOG << " Flit " << received_flit << " buffer full Input[" << i << "][" << vc <<"]" << endl;
-		    assert(i== DIRECTION_LOCAL);
-		}
+		// if a new flit is injected from local PE
+		if (received_flit.src_id == local_id)
+		    power.networkInterface();
+	    }
 
+	    else  // buffer full
+	    {
+		// should not happen with the new TBufferFullStatus control signals    
+		// except for flit coming from local PE, which don't use it 
+		LOG << " Flit " << received_flit << " buffer full Input[" << i << "][" << vc <<"]" << endl;
+		assert(i== DIRECTION_LOCAL);
 	    }
-	    ack_rx[i].write(current_level_rx[i]);
-	    // updates the mask of VCs to prevent incoming data on full buffers
-	    TBufferFullStatus bfs;
-	    for (int vc=0;vc<GlobalParams::n_virtual_channels;vc++)
-		bfs.mask[vc] = buffer[i][vc].IsFull();
-	    buffer_full_status_rx[i].write(bfs);
+
 	}
+	link_rx[i]->writeAck(current_level_rx[i]);
+	// updates the mask of VCs to prevent incoming data on full buffers
+	link_rx[i]->writeBufferFullStatus(buffer_full_status[i]);
     }
 }
 
 void Router::txProcess()
 {
+  PROFILE_SCOPE(PROF_ROUTER_TX);
 
   if (reset.read()) 
     {
       // Clear outputs and indexes of transmitting protocol
       for (int i = 0; i < DIRECTIONS + 2; i++) 
 	{
-	  req_tx[i].write(0);
+	  link_tx[i]->writeReq(0);
 	  current_level_tx[i] = 0;
+	  forwarded_flits[i] = 0;
+	  input_free_cycle[i] = 0;
+	  output_free_cycle[i] = 0;
+	  for (int vc = 0; vc < MAX_VIRTUAL_CHANNELS; vc++)
+	      release_cycle[i][vc] = -1;
 	}
     } 
-  else 
-    { 
-      // 1st phase: Reservation
-      for (int j = 0; j < DIRECTIONS + 2; j++) 
-	{
-	  int i = (start_from_port + j) % (DIRECTIONS + 2);
+  else
+    (this->*tx_cycle)();
+}
 
-	  for (int k = 0;k < GlobalParams::n_virtual_channels; k++)
+void Router::releaseHeldReservations()
+{
+  for (int i = 0; i < DIRECTIONS + 2; i++)
+      for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
+	  if (release_cycle[i][vc] >= 0 && release_cycle[i][vc] <= current_cycle)
 	  {
-	      int vc = (start_from_vc[i]+k)%(GlobalParams::n_virtual_channels);
-	      
-	      // Uncomment to enable deadlock checking on buffers. 
-	      // Please also set the appropriate threshold.
-	      // buffer[i].deadlockCheck();
-
-	      if (!buffer[i][vc].IsEmpty()) 
-	      {
-		  Flit flit = buffer[i][vc].Front();
-		  power.bufferRouterFront();
-
-		  if (flit.flit_type == FLIT_TYPE_HEAD) 
-		    {
-		      // prepare data for routing
-		      RouteData route_data;
-		      route_data.current_id = local_id;
-		      //LOG<< "current_id= "<< route_data.current_id <<" for sending " << flit << endl;
-		      route_data.src_id = flit.src_id;
-		      route_data.dst_id = flit.dst_id;
-		      route_data.dir_in = i;
-		      route_data.vc_id = flit.vc_id;
-
-		      // TODO: see PER POSTERI (adaptive routing should not recompute route if already reserved)
-		      int o = route(route_data);
-
-		      // manage special case of target hub not directly connected to destination
-		      if (o>=DIRECTION_HUB_RELAY)
-			  {
-		      	Flit f = buffer[i][vc].Pop();
-		      	f.hub_relay_node = o-DIRECTION_HUB_RELAY;
-		      	buffer[i][vc].Push(f);
-		      	o = DIRECTION_HUB;
-			  }
+	      TReservation r;
+	      r.input = i;
+	      r.vc = vc;
+	      reservation_table.release(r, held_output[i][vc]);
+	      release_cycle[i][vc] = -1;
+	  }
+}
 
-		      TReservation r;
-		      r.input = i;
-		      r.vc = vc;
+template <int N_VC, int N_PORTS>
+void Router::txCycle()
+{
+  current_cycle = (long) (sc_time_stamp().to_double() / GlobalParams::clock_period_ps);
+  if (GlobalParams::packet_mode)
+      releaseHeldReservations();
 
-		      LOG << " checking availability of Output[" << o << "] for Input[" << i << "][" << vc << "] flit " << flit << endl;
+  // 1st phase: Reservation
+  for (int j = 0; j < DIRECTIONS + 2; j++) 
+    {
+      int i = start_from_port + j;
+      if (i >= DIRECTIONS + 2)
+	  i -= DIRECTIONS + 2;
+      // The round robin still spans all the ports, so that the
+      // arbitration order does not depend on the specialisation
+      if (i >= N_PORTS)
+	  continue;
+
+      for (int k = 0;k < numVCs<N_VC>(); k++)
+      {
+	  int vc = wrapVC<N_VC>(start_from_vc[i]+k);
+	      
+	  // Uncomment to enable deadlock checking on buffers. 
+	  // Please also set the appropriate threshold.
+	  // buffer[i].deadlockCheck();
 
-		      int rt_status = reservation_table.checkReservation(r,o);
+	  if (!buffer[i][vc].IsEmpty()) 
+	  {
+	      Flit flit = buffer[i][vc].Front();
+	      power.bufferRouterFront();
 
-		      if (rt_status == RT_AVAILABLE) 
-		      {
-			  LOG << " reserving direction " << o << " for flit " << flit << endl;
-			  reservation_table.reserve(r, o);
-		      }
-		      else if (rt_status == RT_ALREADY_SAME)
-		      {
-			  LOG << " RT_ALREADY_SAME reserved direction " << o << " for flit " << flit << endl;
-		      }
-		      else if (rt_status == RT_OUTVC_BUSY)
-		      {
-			  LOG << " RT_OUTVC_BUSY reservation direction " << o << " for flit " << flit << endl;
-		      }
-		      else if (rt_status == RT_ALREADY_OTHER_OUT)
+	      if (flit.flit_type == FLIT_TYPE_HEAD) 
+		{
+		  // prepare data for routing
+		  RouteData route_data;
+		  route_data.current_id = local_id;
+		  //LOG<< "current_id= "<< route_data.current_id <<" for sending " << flit << endl;
+		  route_data.src_id = flit.src_id;
+		  route_data.dst_id = flit.dst_id;
+		  route_data.dir_in = i;
+		  route_data.vc_id = flit.vc_id;
+
+		  // TODO: see PER POSTERI (adaptive routing should not recompute route if already reserved)
+		  int o = route(route_data);
+
+		  // manage special case of target hub not directly connected to destination
+		  if (o>=DIRECTION_HUB_RELAY)
 		      {
-			  LOG  << "RT_ALREADY_OTHER_OUT: another output previously reserved for the same flit " << endl;
+		    Flit f = buffer[i][vc].Pop();
+		    f.hub_relay_node = o-DIRECTION_HUB_RELAY;
+		    buffer[i][vc].Push(f);
+		    o = DIRECTION_HUB;
 		      }
-		      else assert(false); // no meaningful status here
-		    }
+
+		  TReservation r;
+		  r.input = i;
+		  r.vc = vc;
+
+		  LOG << " checking availability of Output[" << o << "] for Input[" << i << "][" << vc << "] flit " << flit << endl;
+
+		  int rt_status = reservation_table.checkReservation(r,o);
+
+		  if (rt_status == RT_AVAILABLE) 
+		  {
+		      LOG << " reserving direction " << o << " for flit " << flit << endl;
+		      reservation_table.reserve(r, o);
+		  }
+		  else if (rt_status == RT_ALREADY_SAME)
+		  {
+		      LOG << " RT_ALREADY_SAME reserved direction " << o << " for flit " << flit << endl;
+		  }
+		  else if (rt_status == RT_OUTVC_BUSY)
+		  {
+		      LOG << " RT_OUTVC_BUSY reservation direction " << o << " for flit " << flit << endl;
+		  }
+		  else if (rt_status == RT_ALREADY_OTHER_OUT)
+		  {
+		      LOG  << "RT_ALREADY_OTHER_OUT: another output previously reserved for the same flit " << endl;
+		  }
+		  else assert(false); // no meaningful status here
 		}
-	  }
-	    start_from_vc[i] = (start_from_vc[i]+1)%GlobalParams::n_virtual_channels;
-	}
+	    }
+      }
+	start_from_vc[i] = wrapVC<N_VC>(start_from_vc[i]+1);
+    }
 
-      start_from_port = (start_from_port + 1) % (DIRECTIONS + 2);
+  start_from_port = (start_from_port + 1) % (DIRECTIONS + 2);
 
-      // 2nd phase: Forwarding
-      //if (local_id==6) LOG<<"*TX*****local_id="<<local_id<<"__ack_tx[0]= "<<ack_tx[0].read()<<endl;
-      for (int i = 0; i < DIRECTIONS + 2; i++) 
-      { 
-	  vector<pair<int,int> > reservations = reservation_table.getReservations(i);
+  // 2nd phase: Forwarding
+  //if (local_id==6) LOG<<"*TX*****local_id="<<local_id<<"__ack_tx[0]= "<<ack_tx[0].read()<<endl;
+  for (int i = 0; i < N_PORTS; i++) 
+  { 
+      vector<pair<int,int> > reservations = reservation_table.getReservations(i);
 	  
-	  if (reservations.size()!=0)
-	  {
+      if (reservations.size()!=0)
+      {
 
-	      int rnd_idx = rand()%reservations.size();
+	  int rnd_idx = rand()%reservations.size();
 
-	      int o = reservations[rnd_idx].first;
-	      int vc = reservations[rnd_idx].second;
-	     // LOG<< "found reservation from input= " << i << "_to output= "<<o<<endl;
-	      // can happen
-	      if (!buffer[i][vc].IsEmpty())  
-	      {
-		  // power contribution already computed in 1st phase
-		  Flit flit = buffer[i][vc].Front();
-		  //LOG<< "*****TX***Direction= "<<i<< "************"<<endl;
-		  //LOG<<"_cl_tx="<<current_level_tx[o]<<"req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
+	  int o = reservations[rnd_idx].first;
+	  int vc = reservations[rnd_idx].second;
+	 // LOG<< "found reservation from input= " << i << "_to output= "<<o<<endl;
+	  // can happen
+	  if (!buffer[i][vc].IsEmpty())  
+	  {
+	      // power contribution already computed in 1st phase
+	      Flit flit = buffer[i][vc].Front();
+	      //LOG<< "*****TX***Direction= "<<i<< "************"<<endl;
+	      //LOG<<"_cl_tx="<<current_level_tx[o]<<"req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
 		  
-		  if ( (current_level_tx[o] == ack_tx[o].read()) &&
-		       (buffer_full_status_tx[o].read().mask[vc] == false) ) 
+	      // In packet mode the reservation may still belong to the body
+	      // of the previous packet, and the ports be busy with it
+	      bool link_free = !GlobalParams::packet_mode ||
+		  (release_cycle[i][vc] < 0 &&
+		   current_cycle >= input_free_cycle[i] &&
+		   current_cycle >= output_free_cycle[o]);
+
+	      if ( (current_level_tx[o] == link_tx[o]->readAck()) &&
+		   !link_tx[o]->readBufferFullStatus().isFull(vc) &&
+		   link_free ) 
+	      {
+		  //if (GlobalParams::verbose_mode > VERBOSE_OFF) 
+		  LOG << "Input[" << i << "][" << vc << "] forwarded to Output[" << o << "], flit: " << flit << endl;
+
+		  current_level_tx[o] = 1 - current_level_tx[o];
+		  link_tx[o]->writeFlit(flit, current_level_tx[o]);
+		  RunDigest::forward(current_cycle, local_id, i, o, flit);
+		  buffer[i][vc].Pop();
+		  if (!buffer[i][vc].IsFull())
+		      buffer_full_status[i].clearFull(vc);
+
+		  // Flits accounted for: the whole packet in packet mode
+		  int flits = 1;
+		  if (GlobalParams::packet_mode)
 		  {
-		      //if (GlobalParams::verbose_mode > VERBOSE_OFF) 
-		      LOG << "Input[" << i << "][" << vc << "] forwarded to Output[" << o << "], flit: " << flit << endl;
-
-		      flit_tx[o].write(flit);
-		      current_level_tx[o] = 1 - current_level_tx[o];
-		      req_tx[o].write(current_level_tx[o]);
-		      buffer[i][vc].Pop();
+		      flits = flit.sequence_length;
+		      release_cycle[i][vc] = current_cycle + flits;
+		      held_output[i][vc] = o;
+		      input_free_cycle[i] = current_cycle + flits;
+		      output_free_cycle[o] = current_cycle + flits;
+		  }
+		  forwarded_flits[o] += flits;
 
-		      if (flit.flit_type == FLIT_TYPE_TAIL)
-		      {
-			  TReservation r;
-			  r.input = i;
-			  r.vc = vc;
-			  reservation_table.release(r,o);
-		      }
+		  if (flit.flit_type == FLIT_TYPE_TAIL)
+		  {
+		      TReservation r;
+		      r.input = i;
+		      r.vc = vc;
+		      reservation_table.release(r,o);
+		  }
 
-		      /* Power & Stats ------------------------------------------------- */
+		  /* Power & Stats ------------------------------------------------- */
+		  for (int f = 0; f < flits; f++)
+		  {
 		      if (o == DIRECTION_HUB) power.r2hLink();
 		      else
 			  power.r2rLink();
 
 		      power.bufferRouterPop();
 		      power.crossBar();
+		  }
 
-		      if (o == DIRECTION_LOCAL) 
+		  if (o == DIRECTION_LOCAL) 
+		  {
+		      power.networkInterface();
+		      LOG << "Consumed flit " << flit << endl;
+		      stats.receivedFlit(sc_time_stamp().to_double() / GlobalParams::clock_period_ps, flit);
+		      if (flit.flit_type == FLIT_TYPE_TAIL || GlobalParams::packet_mode)
 		      {
-			  power.networkInterface();
-			  LOG << "Consumed flit " << flit << endl;
-			  stats.receivedFlit(sc_time_stamp().to_double() / GlobalParams::clock_period_ps, flit);
-			  if (GlobalParams:: max_volume_to_be_drained) 
+			  // Delivered packets of a dependency trace release the
+			  // packets waiting for them
+			  long trace_id = PacketTable::traceId(flit.packet_id);
+			  if (trace_id >= 0)
 			  {
-			      if (drained_volume >= GlobalParams:: max_volume_to_be_drained)
+			      traffic_dependency->delivered(trace_id, sc_time_stamp().to_double() / GlobalParams::clock_period_ps + flits - 1);
+			      if (traffic_dependency->completed())
 				  sc_stop();
-			      else 
-			      {
-				  drained_volume++;
-				  local_drained++;
-			      }
 			  }
-		      } 
-		      else if (i != DIRECTION_LOCAL) // not generated locally
-			  routed_flits++;
-		      /* End Power & Stats ------------------------------------------------- */
-			 //LOG<<"END_OK_cl_tx="<<current_level_tx[o]<<"_req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
-		  }
-		  else
-		  {
-		      LOG << " Cannot forward Input[" << i << "][" << vc << "] to Output[" << o << "], flit: " << flit << endl;
-		      //LOG << " **DEBUG APB: current_level_tx: " << current_level_tx[o] << " ack_tx: " << ack_tx[o].read() << endl;
-		      LOG << " **DEBUG buffer_full_status_tx " << buffer_full_status_tx[o].read().mask[vc] << endl;
-
-		  	//LOG<<"END_NO_cl_tx="<<current_level_tx[o]<<"_req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
-		      /*
-		      if (flit.flit_type == FLIT_TYPE_HEAD)
-			  reservation_table.release(i,flit.vc_id,o);
-			  */
-		  }
+			  PacketTable::remove(flit.packet_id);
+		      }
+		      if (GlobalParams:: max_volume_to_be_drained) 
+		      {
+			  if (drained_volume >= GlobalParams:: max_volume_to_be_drained)
+			      sc_stop();
+			  else 
+			  {
+			      drained_volume += flits;
+			      local_drained += flits;
+			  }
+		      }
+		  } 
+		  else if (i != DIRECTION_LOCAL) // not generated locally
+		      routed_flits += flits;
+		  /* End Power & Stats ------------------------------------------------- */
+		     //LOG<<"END_OK_cl_tx="<<current_level_tx[o]<<"_req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
 	      }
-	  } // if not reserved 
-	 // else LOG<<"we have no reservation for direction "<<i<< endl;
-      } // for loop directions
+	      else
+	      {
+		  LOG << " Cannot forward Input[" << i << "][" << vc << "] to Output[" << o << "], flit: " << flit << endl;
+		  //LOG << " **DEBUG APB: current_level_tx: " << current_level_tx[o] << " ack_tx: " << ack_tx[o].read() << endl;
+		  LOG << " **DEBUG buffer_full_status_tx " << link_tx[o]->readBufferFullStatus().isFull(vc) << endl;
+
+		    //LOG<<"END_NO_cl_tx="<<current_level_tx[o]<<"_req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
+		  /*
+		  if (flit.flit_type == FLIT_TYPE_HEAD)
+		      reservation_table.release(i,flit.vc_id,o);
+		      */
+	      }
+	  }
+      } // if not reserved 
+     // else LOG<<"we have no reservation for direction "<<i<< endl;
+  } // for loop directions
 
-      if ((int)(sc_time_stamp().to_double() / GlobalParams::clock_period_ps)%2==0)
-	  reservation_table.updateIndex();
-    }   
+  if ((int)(sc_time_stamp().to_double() / GlobalParams::clock_period_ps)%2==0)
+      reservation_table.updateIndex();
 }
 
 NoP_data Router::getCurrentNoPData()
 {
     NoP_data NoP_data;
 
-    for (int j = 0; j < DIRECTIONS; j++) {
-	try {
-		NoP_data.channel_status_neighbor[j].free_slots = free_slots_neighbor[j].read();
-		NoP_data.channel_status_neighbor[j].available = (reservation_table.isNotReserved(j));
-	}
-	catch (int e)
-	{
-	    if (e!=NOT_VALID) assert(false);
-	    // Nothing to do if an NOT_VALID direction is caught
-	};
-    }
+    for (int j = 0; j < DIRECTIONS; j++)
+	NoP_data.free_slots[j] = link_tx[j]->readFreeSlots();
 
+    NoP_data.available_mask = reservation_table.notReservedMask() & ((1u << DIRECTIONS) - 1);
     NoP_data.sender_id = local_id;
 
     return NoP_data;
@@ -296,9 +424,13 @@ void Router::perCycleUpdate()
 {
     if (reset.read()) {
 	for (int i = 0; i < DIRECTIONS + 1; i++)
-	    free_slots[i].write(buffer[i][DEFAULT_VC].GetMaxBufferSize());
+	    link_rx[i]->writeFreeSlots(buffer[i][DEFAULT_VC].GetMaxBufferSize());
     } else {
+#ifdef FIXED_SELECTION
+        fixed_selection->FIXED_SELECTION_CLASS::perCycleUpdate(this);
+#else
         selectionStrategy->perCycleUpdate(this);
+#endif
 
 	power.leakageRouter();
 	for (int i = 0; i < DIRECTIONS + 1; i++)
@@ -314,81 +446,6 @@ void Router::perCycleUpdate()
     }
 }
 
-vector<int> Router::nextDeltaHops(RouteData rd) {
-
-	if (GlobalParams::topology == TOPOLOGY_MESH)
-	{
-		cout << "Mesh topologies are not supported for nextDeltaHops() ";
-		assert(false);
-	}
-	// annotate the initial nodes
-	int src = rd.src_id;
-	int dst = rd.dst_id;
-
-	int current_node = src;
-	vector<int> direction; // initially is empty
-	vector<int> next_hops;
-
-	int sw = GlobalParams::n_delta_tiles/2; //sw: switch number in each stage
-	int stg = log2(GlobalParams::n_delta_tiles);
-	int c;
-	//---From Source to stage 0 (return the sw attached to the source)---
-	//Topology omega 
-	if (GlobalParams::topology == TOPOLOGY_OMEGA) 	
-	{
-	if(current_node < (GlobalParams::n_delta_tiles/2))	
-		 c = current_node;
-	else if(current_node >= (GlobalParams::n_delta_tiles/2))	
-		 c = (current_node - (GlobalParams::n_delta_tiles/2));		
-	}
-	//Other delta topologies: Butterfly and baseline
-	else if ((GlobalParams::topology == TOPOLOGY_BUTTERFLY)||(GlobalParams::topology == TOPOLOGY_BASELINE))
-	{
-		 c =  (current_node >>1);
-	}
-
-		Coord temp_coord;
-		temp_coord.x = 0;
-		temp_coord.y = c;
-		int N = coord2Id(temp_coord);
-
-		next_hops.push_back(N);
-		current_node = N;
-	
-	
-   //---From stage 0 to Destination---
-	int current_stage = 0;
-
-	while (current_stage<stg-1)
-	{
-		Coord new_coord;
-		int y = id2Coord(current_node).y;
-
-		rd.current_id = current_node;
-		direction = routingAlgorithm->route(this, rd);
-
-		int bit_to_check = stg - current_stage - 1;
-
-		int bit_checked = (y & (1 << (bit_to_check - 1)))>0 ? 1:0;
-
-		// computes next node coords
-		new_coord.x = current_stage + 1;
-		if (bit_checked ^ direction[0])
-			new_coord.y = toggleKthBit(y, bit_to_check);
-		else
-			new_coord.y = y;
-
-		current_node = coord2Id(new_coord);
-		next_hops.push_back(current_node);
-		current_stage = id2Coord(current_node).x;
-	}
-
-	next_hops.push_back(dst);
-
-	return next_hops;
-
-}
-
 vector < int > Router::routingFunction(const RouteData & route_data)
 {
 	if (GlobalParams::use_winoc)
@@ -402,47 +459,24 @@ vector < int > Router::routingFunction(const RouteData & route_data)
 		// node I and the destination D.
 		// - NOTE: default threshold is 0, which means I=D, i.e., we explicitly ask the destination D to be connected to the
 		// target radio hub
-		if (hasRadioHub(local_id))
+		// - All of this only depends on the hub of the current node, on the
+		// destination and (for relaying) on the source: the decision is
+		// looked up in the table built by the NoC at elaboration
+		int direction = wireless_table->decision(local_id, route_data.src_id, route_data.dst_id);
+
+		if (direction == DIRECTION_HUB)
 		{
-			// Check if destination is directly connected to an hub
-			if ( hasRadioHub(route_data.dst_id) &&
-				 !sameRadioHub(local_id,route_data.dst_id) )
-			{
-                map<int, int>::iterator it1 = GlobalParams::hub_for_tile.find(route_data.dst_id);
-                map<int, int>::iterator it2 = GlobalParams::hub_for_tile.find(route_data.current_id);
-
-                if (connectedHubs(it1->second,it2->second))
-                {
-                    LOG << "Destination node " << route_data.dst_id << " is directly connected to a reachable RadioHub" << endl;
-                    vector<int> dirv;
-                    dirv.push_back(DIRECTION_HUB);
-                    return dirv;
-                }
-			}
-			// let's check whether some node in the route has an acceptable distance to the dst
-            if (GlobalParams::winoc_dst_hops>0)
-            {
-                // TODO: for the moment, just print the set of nexts hops to check everything is ok
-                LOG << "NEXT_DELTA_HOPS (from node " << route_data.src_id << " to " << route_data.dst_id << ") >>>> :";
-                vector<int> nexthops;
-                nexthops = nextDeltaHops(route_data);
-                //for (int i=0;i<nexthops.size();i++) cout << "(" << nexthops[i] <<")-->";
-                //cout << endl;
-                for (int i=1;i<=GlobalParams::winoc_dst_hops;i++)
-				{
-                	int dest_position = nexthops.size()-1;
-                	int candidate_hop = nexthops[dest_position-i];
-					if ( hasRadioHub(candidate_hop) && !sameRadioHub(local_id,candidate_hop) ) {
-						//LOG << "Checking candidate hop " << candidate_hop << " ... It's OK!" << endl;
-						LOG << "Relaying to hub-connected node " << candidate_hop << " to reach destination " << route_data.dst_id << endl;
-						vector<int> dirv;
-						dirv.push_back(DIRECTION_HUB_RELAY+candidate_hop);
-						return dirv;
-					}
-					//else
-					// LOG << "Checking candidate hop " << candidate_hop << " ... NOT OK" << endl;
-				}
-            }
+			LOG << "Destination node " << route_data.dst_id << " is directly connected to a reachable RadioHub" << endl;
+			vector<int> dirv;
+			dirv.push_back(DIRECTION_HUB);
+			return dirv;
+		}
+		if (direction != NOT_VALID)
+		{
+			LOG << "Relaying to hub-connected node " << direction - DIRECTION_HUB_RELAY << " to reach destination " << route_data.dst_id << endl;
+			vector<int> dirv;
+			dirv.push_back(direction);
+			return dirv;
 		}
 	}
 	// TODO: fix all the deprecated verbose mode logs
@@ -450,7 +484,11 @@ vector < int > Router::routingFunction(const RouteData & route_data)
 		LOG << "Wired routing for dst = " << route_data.dst_id << endl;
 
 	// not wireless direction taken, apply normal routing
+#ifdef FIXED_ROUTING
+	return fixed_routing->FIXED_ROUTING_CLASS::route(this, route_data);
+#else
 	return routingAlgorithm->route(this, route_data);
+#endif
 }
 
 int Router::route(const RouteData & route_data)
@@ -472,7 +510,7 @@ void Router::NoP_report() const
 	LOG << "NoP report: " << endl;
 
     for (int i = 0; i < DIRECTIONS; i++) {
-	NoP_tmp = NoP_data_in[i].read();
+	NoP_tmp = link_tx[i]->readNoPData();
 	if (NoP_tmp.sender_id != NOT_VALID)
 	    cout << NoP_tmp;
     }
@@ -485,19 +523,13 @@ int Router::NoPScore(const NoP_data & nop_data,
 {
     int score = 0;
 
-    for (unsigned int i = 0; i < nop_channels.size(); i++) {
-	int available;
-
-	if (nop_data.channel_status_neighbor[nop_channels[i]].available)
-	    available = 1;
-	else
-	    available = 0;
-
-	int free_slots =
-	    nop_data.channel_status_neighbor[nop_channels[i]].free_slots;
+    // Only the free slots of the available channels count
+    unsigned int candidates = 0;
+    for (unsigned int i = 0; i < nop_channels.size(); i++)
+	candidates |= 1u << nop_channels[i];
 
-	score += available * free_slots;
-    }
+    for (unsigned int m = candidates & nop_data.available_mask; m != 0; m &= m - 1)
+	score += nop_data.free_slots[__builtin_ctz(m)];
 
     return score;
 }
@@ -509,7 +541,11 @@ int Router::selectionFunction(const vector < int >&directions,
     if (directions.size() == 1)
 	return directions[0];
 
+#ifdef FIXED_SELECTION
+    return fixed_selection->FIXED_SELECTION_CLASS::apply(this, directions, route_data);
+#else
     return selectionStrategy->apply(this, directions, route_data);
+#endif
 }
 
 void Router::configure(const int _id,
@@ -536,10 +572,11 @@ void Router::configure(const int _id,
 	    buffer[i][vc].setLabel(string(name())+"->buffer["+i_to_string(i)+"]");
 	}
 	start_from_vc[i] = 0;
+	forwarded_flits[i] = 0;
     }
 
 
-    if (GlobalParams::topology == TOPOLOGY_MESH)
+    if (GlobalParams::topology_type == TOPOLOGY_TYPE_MESH)
     {
 	int row = _id / GlobalParams::mesh_dim_x;
 	int col = _id % GlobalParams::mesh_dim_x;
@@ -583,7 +620,7 @@ int Router::reflexDirection(int direction) const
 
 int Router::getNeighborId(int _id, int direction) const
 {
-    assert(GlobalParams::topology == TOPOLOGY_MESH);
+    assert(GlobalParams::topology_type == TOPOLOGY_TYPE_MESH);
 
     Coord my_coord = id2Coord(_id); 
 
@@ -622,9 +659,10 @@ bool Router::inCongestion()
 {
     for (int i = 0; i < DIRECTIONS; i++) {
 
-	if (free_slots_neighbor[i]==NOT_VALID) continue;
+	int free_slots = link_tx[i]->readFreeSlots();
+	if (free_slots==NOT_VALID) continue;
 
-	int flits = GlobalParams::buffer_depth - free_slots_neighbor[i];
+	int flits = GlobalParams::buffer_depth - free_slots;
 	if (flits > (int) (GlobalParams::buffer_depth * GlobalParams::dyad_threshold))
 	    return true;
     }
@@ -638,23 +676,3 @@ void Router::ShowBuffersStats(std::ostream & out)
       for (int vc=0; vc<GlobalParams::n_virtual_channels;vc++)
 	    buffer[i][vc].ShowStats(out);
 }
-
-
-bool Router::connectedHubs(int src_hub, int dst_hub) {
-    vector<int> &first = GlobalParams::hub_configuration[src_hub].txChannels;
-    vector<int> &second = GlobalParams::hub_configuration[dst_hub].rxChannels;
-
-    vector<int> intersection;
-
-    for (unsigned int i = 0; i < first.size(); i++) {
-        for (unsigned int j = 0; j < second.size(); j++) {
-            if (first[i] == second[j])
-                intersection.push_back(first[i]);
-        }
-    }
-
-    if (intersection.size() == 0)
-        return false;
-    else
-        return true;
-}
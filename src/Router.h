@@ -18,6 +18,10 @@
 #include "GlobalRoutingTable.h"
 #include "LocalRoutingTable.h"
 #include "ReservationTable.h"
+#include "Topology.h"
+#include "WirelessRoutingTable.h"
+#include "GlobalTrafficDependency.h"
+#include "LinkChannel.h"
 #include "Utils.h"
 #include "routingAlgorithms/RoutingAlgorithm.h"
 #include "routingAlgorithms/RoutingAlgorithms.h"
@@ -40,22 +44,8 @@ SC_MODULE(Router)
     sc_in <bool> reset;                           // The reset signal for the router
 
     // number of ports: 4 mesh directions + local + wireless 
-    sc_in <Flit> flit_rx[DIRECTIONS + 2];	  // The input channels 
-    sc_in <bool> req_rx[DIRECTIONS + 2];	  // The requests associated with the input channels
-    sc_out <bool> ack_rx[DIRECTIONS + 2];	  // The outgoing ack signals associated with the input channels
-    sc_out <TBufferFullStatus> buffer_full_status_rx[DIRECTIONS+2];
-
-    sc_out <Flit> flit_tx[DIRECTIONS + 2];   // The output channels
-    sc_out <bool> req_tx[DIRECTIONS + 2];	  // The requests associated with the output channels
-    sc_in <bool> ack_tx[DIRECTIONS + 2];	  // The outgoing ack signals associated with the output channels
-    sc_in <TBufferFullStatus> buffer_full_status_tx[DIRECTIONS+2];
-
-    sc_out <int> free_slots[DIRECTIONS + 1];
-    sc_in <int> free_slots_neighbor[DIRECTIONS + 1];
-
-    // Neighbor-on-Path related I/O
-    sc_out < NoP_data > NoP_data_out[DIRECTIONS];
-    sc_in < NoP_data > NoP_data_in[DIRECTIONS];
+    sc_port <LinkRxIf> link_rx[DIRECTIONS + 2];	  // The input links: flit and req in, ack, buffer status, free slots and NoP data out
+    sc_port <LinkTxIf> link_tx[DIRECTIONS + 2];	  // The output links: flit and req out, ack, buffer status, free slots and NoP data in
 
     // Registers
 
@@ -65,13 +55,19 @@ SC_MODULE(Router)
     BufferBank buffer[DIRECTIONS + 2];		// buffer[direction][virtual_channel] 
     bool current_level_rx[DIRECTIONS + 2];	// Current level for Alternating Bit Protocol (ABP)
     bool current_level_tx[DIRECTIONS + 2];	// Current level for Alternating Bit Protocol (ABP)
+    TBufferFullStatus buffer_full_status[DIRECTIONS + 2];	// Full VCs of each input, updated on push/pop
     Stats stats;		                // Statistics
     Power power;
     LocalRoutingTable routing_table;		// Routing table
     ReservationTable reservation_table;		// Switch reservation table
     unsigned long routed_flits;
+    unsigned long forwarded_flits[DIRECTIONS + 2];	// flits sent through each output port
     RoutingAlgorithm * routingAlgorithm; 
     SelectionStrategy * selectionStrategy; 
+    TopologyGraph * topology;			// Needed by delta routing (path tables)
+    WirelessRoutingTable * wireless_table;	// Needed with winoc
+    GlobalTrafficDependency * traffic_dependency;	// Notified of delivered trace packets
+    char *random_state;				// Own rand() stream of partitioned runs
     
     // Functions
 
@@ -88,6 +84,13 @@ SC_MODULE(Router)
     // Constructor
 
     SC_CTOR(Router) {
+        topology = NULL;
+        wireless_table = NULL;
+        traffic_dependency = NULL;
+        random_state = NULL;
+        current_cycle = 0;
+        selectCycles();
+
         SC_METHOD(process);
         sensitive << reset;
         sensitive << clock.pos();
@@ -133,14 +136,34 @@ SC_MODULE(Router)
     int start_from_port;	     // Port from which to start the reservation cycle
     int start_from_vc[DIRECTIONS+2]; // VC from which to start the reservation cycle for the specific port
 
-    vector<int> nextDeltaHops(RouteData rd);
+
+    // Per-cycle bodies of rxProcess() and txProcess(), specialised on the
+    // number of VCs (1, 2, 4, or 0 for any) and of active ports (the hub
+    // port is skipped without winoc). selectCycles() picks the
+    // specialisation matching the configuration
+    template <int N_VC, int N_PORTS> void rxCycle();
+    template <int N_VC, int N_PORTS> void txCycle();
+    template <int N_VC> void bindCycles();
+    void selectCycles();
+    void (Router::*rx_cycle)();
+    void (Router::*tx_cycle)();
+
+    long current_cycle;		// of the running txCycle()
+
+    // Packet mode: the head stands for its whole packet. Once it is
+    // forwarded, the input VC keeps its reservation, and the input and
+    // output ports their bandwidth, until the body would have streamed
+    // through
+    long release_cycle[DIRECTIONS + 2][MAX_VIRTUAL_CHANNELS];	// -1 if not held
+    int held_output[DIRECTIONS + 2][MAX_VIRTUAL_CHANNELS];
+    long input_free_cycle[DIRECTIONS + 2];
+    long output_free_cycle[DIRECTIONS + 2];
+    void releaseHeldReservations();
   public:
     unsigned int local_drained;
 
     bool inCongestion();
     void ShowBuffersStats(std::ostream & out);
-
-    bool connectedHubs(int src_hub, int dst_hub);
 };
 
 #endif
@@ -0,0 +1,116 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the run digest
+ */
+
+#include "RunDigest.h"
+#include "PacketTable.h"
+
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME        0x100000001b3ULL
+
+bool RunDigest::enabled = false;
+uint64_t RunDigest::digest = FNV_OFFSET_BASIS;
+long RunDigest::open_cycle = -1;
+uint64_t RunDigest::cycle_hash = 0;
+unsigned long RunDigest::events = 0;
+FILE *RunDigest::trace = NULL;
+map<int, uint64_t> RunDigest::node_hash;
+
+// FNV-1a, one 64 bit word at a time
+static inline uint64_t fnv(uint64_t h, const uint64_t word)
+{
+    for (int i = 0; i < 8; i++) {
+	h ^= (word >> (8 * i)) & 0xff;
+	h *= FNV_PRIME;
+    }
+    return h;
+}
+
+// Final mix of splitmix64, so that the sums of the event hashes of a cycle
+// do not cancel out
+static inline uint64_t mix(uint64_t h)
+{
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+bool RunDigest::openTrace(const char *fname)
+{
+    trace = fopen(fname, "w");
+    return trace != NULL;
+}
+
+void RunDigest::event(const long cycle, const int node, const int kind,
+		      const int in, const int out, const Flit & flit)
+{
+    if (cycle != open_cycle) {
+	closeCycle();
+	open_cycle = cycle;
+    }
+
+    uint64_t h = FNV_OFFSET_BASIS;
+    h = fnv(h, node);
+    h = fnv(h, kind | (in << 8) | (out << 16) | ((uint64_t) flit.vc_id << 24));
+    h = fnv(h, ((uint64_t) (uint32_t) flit.src_id << 32) | (uint32_t) flit.dst_id);
+    h = fnv(h, (uint64_t) PacketTable::timestamp(flit.packet_id));
+    h = fnv(h, ((uint64_t) flit.sequence_no << 32) | (uint32_t) flit.sequence_length);
+    h = mix(h);
+
+    cycle_hash += h;
+    events++;
+    if (trace != NULL)
+	node_hash[node] += h;
+}
+
+void RunDigest::closeCycle()
+{
+    if (open_cycle < 0)
+	return;
+
+    digest = fnv(digest, open_cycle);
+    digest = fnv(digest, cycle_hash);
+
+    if (trace != NULL) {
+	for (map<int, uint64_t>::const_iterator i = node_hash.begin(); i != node_hash.end(); i++)
+	    fprintf(trace, "%ld %d %016llx\n", open_cycle, i->first, (unsigned long long) i->second);
+	node_hash.clear();
+    }
+
+    open_cycle = -1;
+    cycle_hash = 0;
+}
+
+uint64_t RunDigest::value()
+{
+    closeCycle();
+    if (trace != NULL)
+	fflush(trace);
+
+    return digest;
+}
+
+bool RunDigest::showResult(std::ostream & out, const string & golden)
+{
+    ostringstream hex;
+    hex << setw(16) << setfill('0') << std::hex << value();
+
+    out << "% Run digest: " << hex.str() << " (" << events << " events)" << endl;
+    if (golden.empty())
+	return true;
+
+    bool match = (strtoull(golden.c_str(), NULL, 16) == value());
+    out << "% Digest check: " << (match ? "passed" : "FAILED, expected " + golden) << endl;
+
+    return match;
+}
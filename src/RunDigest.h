@@ -0,0 +1,76 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the run digest
+ */
+
+#ifndef __NOXIMRUNDIGEST_H__
+#define __NOXIMRUNDIGEST_H__
+
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include <stdint.h>
+#include "DataStructs.h"
+
+using namespace std;
+
+// Kinds of event hashed
+#define DIGEST_EVENT_INJECT  0	// flit sent by a PE to its router
+#define DIGEST_EVENT_FORWARD 1	// flit sent by a router from an input to an output
+
+// Rolling hash of the cycle-level behaviour of a run: every flit injected
+// by a PE and every flit forwarded by a router (cycle, node, ports, VC and
+// the identity of the flit: source, destination, generation cycle and
+// sequence number). Events of the same cycle are combined regardless of
+// their order, so that the digest does not depend on the order in which
+// the kernel runs the processes, then cycles are chained in order. Packet
+// ids are not hashed, as they only index the PacketTable. Two runs with
+// the same digest behaved the same, flit by flit. When disabled an event
+// costs a test of enabled
+class RunDigest {
+
+  public:
+
+    static bool enabled;
+
+    // Also writes a "cycle node hash" line per node with events in each
+    // cycle, the input of other/noxim_divergence.sh
+    static bool openTrace(const char *fname);
+
+    static inline void inject(const long cycle, const int node, const Flit & flit) {
+	if (enabled)
+	    event(cycle, node, DIGEST_EVENT_INJECT, DIRECTION_LOCAL, DIRECTION_LOCAL, flit);
+    }
+
+    static inline void forward(const long cycle, const int node, const int in, const int out, const Flit & flit) {
+	if (enabled)
+	    event(cycle, node, DIGEST_EVENT_FORWARD, in, out, flit);
+    }
+
+    // Closes the last cycle
+    static uint64_t value();
+
+    // Shows the digest and, if golden is not empty, whether it matches.
+    // Returns false on a mismatch
+    static bool showResult(std::ostream & out, const string & golden);
+
+  private:
+
+    static uint64_t digest;
+    static long open_cycle;		// cycle whose events are being combined
+    static uint64_t cycle_hash;
+    static unsigned long events;
+    static FILE *trace;
+    static map<int, uint64_t> node_hash;	// of open_cycle, when tracing
+
+    static void event(const long cycle, const int node, const int kind,
+		      const int in, const int out, const Flit & flit);
+    static void closeCycle();
+};
+
+#endif
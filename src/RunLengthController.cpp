@@ -0,0 +1,308 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the adaptive run-length controller
+ */
+
+#include "RunLengthController.h"
+#include "NoC.h"
+
+#include <cmath>
+
+bool RunLengthController::enabled = false;
+BatchSample RunLengthController::current = { 0.0, 0, 0, 0.0 };
+
+RunLengthController::RunLengthController(NoC * _noc)
+{
+    noc = _noc;
+
+    if (GlobalParams::topology == TOPOLOGY_MESH)
+	n_sources = GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y;
+    else
+	n_sources = GlobalParams::n_delta_tiles;
+
+    batch_cycles = GlobalParams::adaptive_batch_cycles;
+    warmed_up = false;
+    saturated = false;
+    converged = false;
+    warm_up_time = 0;
+    transient_end = 0;
+
+    current.delay_sum = 0.0;
+    current.packets = 0;
+    current.flits = 0;
+    enabled = true;
+}
+
+void RunLengthController::receivedFlit(const double delay, const bool head, const unsigned int flits)
+{
+    current.flits += flits;
+    if (head)
+    {
+	current.delay_sum += delay;
+	current.packets++;
+    }
+}
+
+double RunLengthController::studentT975(const int dof)
+{
+    static const double t[] = {
+	12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+	2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+	2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+
+    if (dof < 1)
+	return t[0];
+    if (dof <= 30)
+	return t[dof - 1];
+    return 1.96;
+}
+
+int RunLengthController::mser(const vector<double> & x)
+{
+    int n = x.size();
+    int best = 0;
+    double best_value = -1;
+
+    // Statistics of the tail x[d..n-1] are obtained by adding one sample
+    // at a time from the end of the series
+    vector<double> value(n, 0.0);
+    double sum = 0, sum_sq = 0;
+    for (int d = n - 1; d >= 0; d--)
+    {
+	sum += x[d];
+	sum_sq += x[d] * x[d];
+	int m = n - d;
+	double sse = sum_sq - sum * sum / m;
+	value[d] = sse / ((double) m * m);
+    }
+
+    // Leave at least a couple of samples to estimate the variance
+    for (int d = 0; d < n - 2; d++)
+	if (best_value < 0 || value[d] < best_value)
+	{
+	    best_value = value[d];
+	    best = d;
+	}
+
+    return best;
+}
+
+ConfidenceInterval RunLengthController::batchMeans(const vector<double> & x)
+{
+    ConfidenceInterval ci;
+    int k = x.size();
+
+    ci.mean = 0;
+    ci.half_width = 0;
+    if (k == 0)
+	return ci;
+
+    for (int i = 0; i < k; i++)
+	ci.mean += x[i];
+    ci.mean /= k;
+
+    if (k < 2)
+	return ci;
+
+    double var = 0;
+    for (int i = 0; i < k; i++)
+	var += (x[i] - ci.mean) * (x[i] - ci.mean);
+    var /= (k - 1);
+
+    ci.half_width = studentT975(k - 1) * sqrt(var / k);
+
+    return ci;
+}
+
+vector<double> RunLengthController::getDelaySeries() const
+{
+    vector<double> x;
+
+    // Batches without received packets carry no delay information
+    for (unsigned int i = 0; i < batches.size(); i++)
+	if (batches[i].packets > 0)
+	    x.push_back(batches[i].delay_sum / batches[i].packets);
+
+    return x;
+}
+
+double RunLengthController::delaySeriesStart(const int d) const
+{
+    // Skip the empty batches, as getDelaySeries() does
+    double start = warm_up_time;
+    int sample = 0;
+
+    for (unsigned int i = 0; i < batches.size(); i++)
+    {
+	if (batches[i].packets > 0 && sample++ == d)
+	    break;
+	start += batches[i].cycles;
+    }
+
+    return start;
+}
+
+vector<double> RunLengthController::getThroughputSeries() const
+{
+    vector<double> x;
+
+    for (unsigned int i = 0; i < batches.size(); i++)
+	x.push_back(batches[i].flits / batches[i].cycles);
+
+    return x;
+}
+
+ConfidenceInterval RunLengthController::getDelayInterval() const
+{
+    return batchMeans(getDelaySeries());
+}
+
+ConfidenceInterval RunLengthController::getThroughputInterval() const
+{
+    return batchMeans(getThroughputSeries());
+}
+
+void RunLengthController::mergeBatches()
+{
+    // Adjacent batches are merged so that their number stays bounded and
+    // the correlation between consecutive batch means decreases
+    vector<BatchSample> merged;
+
+    for (unsigned int i = 0; i + 1 < batches.size(); i += 2)
+    {
+	BatchSample b = batches[i];
+	b.delay_sum += batches[i + 1].delay_sum;
+	b.packets += batches[i + 1].packets;
+	b.flits += batches[i + 1].flits;
+	b.cycles += batches[i + 1].cycles;
+	merged.push_back(b);
+    }
+    if (batches.size() % 2)
+	merged.push_back(batches.back());
+
+    batches = merged;
+    batch_cycles *= 2;
+}
+
+bool RunLengthController::queuesGrowing(const vector<unsigned long> & queued, const int n_sources)
+{
+    int n = queued.size();
+
+    if (n <= RLC_SATURATION_WINDOW)
+	return false;
+
+    if (queued[n - 1] < (unsigned long) RLC_SATURATION_QUEUE * n_sources)
+	return false;
+
+    // Source queues keep growing: the network cannot sustain the offered load
+    int growing = 0;
+    for (int i = n - RLC_SATURATION_WINDOW; i < n; i++)
+	if (queued[i] > queued[i - 1])
+	    growing++;
+
+    return growing >= RLC_SATURATION_WINDOW - 1;
+}
+
+bool RunLengthController::endBatch(const double cycle)
+{
+    current.cycles = cycle - warm_up_time;
+    for (unsigned int i = 0; i < batches.size(); i++)
+	current.cycles -= batches[i].cycles;
+
+    batches.push_back(current);
+    queued.push_back(noc->getQueuedPackets());
+
+    current.delay_sum = 0.0;
+    current.packets = 0;
+    current.flits = 0;
+
+    // Bounded source queues cannot grow: they stay full instead
+    if (queuesGrowing(queued, n_sources) || noc->getSaturatedSources() > 0)
+    {
+	saturated = true;
+	if (!warmed_up)
+	{
+	    warmed_up = true;
+	    transient_end = warm_up_time = cycle;
+	    batches.clear();
+	}
+	return true;
+    }
+
+    if (!warmed_up)
+    {
+	vector<double> x = getDelaySeries();
+
+	if ((int) x.size() >= RLC_MIN_BATCHES)
+	{
+	    int d = mser(x);
+
+	    // The truncation point is reliable only in the first half of the run
+	    if (d <= (int) x.size() / 2)
+	    {
+		warmed_up = true;
+		transient_end = delaySeriesStart(d);
+	    }
+	}
+
+	// Safety net: give up searching for the transient at half the cycle cap
+	if (!warmed_up && cycle >= GlobalParams::simulation_time / 2)
+	{
+	    warmed_up = true;
+	    transient_end = cycle;
+	}
+
+	if (warmed_up)
+	{
+	    // Statistics restart now so that the batch means and the
+	    // final statistics cover exactly the same window
+	    warm_up_time = cycle;
+	    batches.clear();
+	    batch_cycles = GlobalParams::adaptive_batch_cycles;
+	}
+	return false;
+    }
+
+    if ((int) batches.size() >= RLC_MAX_BATCHES)
+	mergeBatches();
+
+    if ((int) batches.size() < RLC_MIN_BATCHES)
+	return false;
+
+    ConfidenceInterval delay = getDelayInterval();
+    ConfidenceInterval throughput = getThroughputInterval();
+
+    converged = delay.relative() <= GlobalParams::adaptive_precision &&
+	throughput.relative() <= GlobalParams::adaptive_precision;
+
+    return converged;
+}
+
+void RunLengthController::showReport(std::ostream & out) const
+{
+    ConfidenceInterval delay = getDelayInterval();
+    ConfidenceInterval throughput = getThroughputInterval();
+
+    out << "% Adaptive run length" << endl;
+    out << "% Transient end estimated by MSER at (cycles): " << transient_end << endl;
+    out << "% Statistics collected from the detection, at (cycles): " << warm_up_time << endl;
+    out << "% Number of batches: " << batches.size() << " (" << batch_cycles << " cycles each)" << endl;
+    out << "% Average delay 95% CI (cycles): " << delay.mean << " +/- " << delay.half_width
+	<< " (" << 100 * delay.relative() << "%)" << endl;
+    out << "% Network throughput 95% CI (flits/cycle): " << throughput.mean << " +/- " << throughput.half_width
+	<< " (" << 100 * throughput.relative() << "%)" << endl;
+
+    if (saturated)
+	out << "% Stopped: saturation detected (source queues growing, " << queued.back() << " packets queued)" << endl;
+    else if (converged)
+	out << "% Stopped: requested precision of " << 100 * GlobalParams::adaptive_precision << "% reached" << endl;
+    else
+	out << "% Stopped: cycle cap reached before the requested precision" << endl;
+    out << endl;
+}
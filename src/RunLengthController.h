@@ -0,0 +1,109 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the adaptive run-length controller
+ */
+
+#ifndef __NOXIMRUNLENGTHCONTROLLER_H__
+#define __NOXIMRUNLENGTHCONTROLLER_H__
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// Minimum number of batches for warm-up detection and for confidence intervals
+#define RLC_MIN_BATCHES        10
+// When this number of batches is reached, adjacent batches are merged
+#define RLC_MAX_BATCHES        64
+// Number of consecutive batches inspected for source queue growth
+#define RLC_SATURATION_WINDOW  8
+// Average queued packets per source above which growth means saturation
+#define RLC_SATURATION_QUEUE   4
+
+struct NoC;
+
+struct BatchSample {
+    double delay_sum;		// sum of the delays of the head flits received
+    unsigned long packets;	// head flits received
+    unsigned long flits;	// flits received
+    double cycles;		// batch length
+};
+
+struct ConfidenceInterval {
+    double mean;
+    double half_width;
+
+    double relative() const { return mean != 0 ? half_width / mean : 0; }
+};
+
+class RunLengthController {
+
+  public:
+
+    RunLengthController(NoC * _noc);
+
+    // Sample collection, fed by Stats::receivedFlit
+    static bool enabled;
+    static void receivedFlit(const double delay, const bool head, const unsigned int flits = 1);
+
+    // Closes the current batch at the given cycle (counted from the end
+    // of the reset). Returns true when the simulation can be stopped
+    bool endBatch(const double cycle);
+
+    // Length of the next batch [cycles]
+    int getBatchCycles() const { return batch_cycles; }
+
+    bool isWarmedUp() const { return warmed_up; }
+    bool isSaturated() const { return saturated; }
+    bool isConverged() const { return converged; }
+
+    // Cycle at which statistics collection restarted
+    double getWarmUpTime() const { return warm_up_time; }
+
+    ConfidenceInterval getDelayInterval() const;
+    ConfidenceInterval getThroughputInterval() const;
+
+    void showReport(std::ostream & out) const;
+
+    // 0.975 quantile of the Student t distribution
+    static double studentT975(const int dof);
+
+    // MSER truncation point of a series (index of the first sample to keep)
+    static int mser(const vector<double> & x);
+
+    // Confidence interval of the mean of a series of batch means
+    static ConfidenceInterval batchMeans(const vector<double> & x);
+
+    // True when the source queue occupancy sampled at the end of
+    // consecutive intervals keeps growing beyond the saturation threshold
+    static bool queuesGrowing(const vector<unsigned long> & queued, const int n_sources);
+
+  private:
+
+    NoC *noc;
+    int n_sources;
+
+    int batch_cycles;
+    vector<BatchSample> batches;	// batches since the last statistics restart
+    vector<unsigned long> queued;	// source queue occupancy at the end of each batch
+
+    bool warmed_up;
+    bool saturated;
+    bool converged;
+    double warm_up_time;
+    double transient_end;		// end of the transient found by MSER
+
+    static BatchSample current;
+
+    void mergeBatches();
+    vector<double> getDelaySeries() const;
+    double delaySeriesStart(const int d) const;	// cycle the d-th delay sample starts at
+    vector<double> getThroughputSeries() const;
+};
+
+#endif
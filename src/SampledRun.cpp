@@ -0,0 +1,178 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the sampled simulation
+ */
+
+#include "SampledRun.h"
+#include "RunLengthController.h"
+#include "GlobalStats.h"
+
+#include <algorithm>
+
+SampledRun::SampledRun(NoC * _noc)
+{
+    noc = _noc;
+
+    if (GlobalParams::topology == TOPOLOGY_MESH)
+    {
+	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
+	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
+		pes.push_back(noc->t[x][y]->pe);
+    }
+    else
+    {
+	for (int i = 0; i < GlobalParams::n_delta_tiles; i++)
+	    pes.push_back(noc->core[i]->pe);
+    }
+
+    network.build(noc->topology);
+
+    horizon = GlobalParams::simulation_time;
+    covered = 0;
+    detailed = 0;
+    received_flits = 0;
+}
+
+double SampledRun::now() const
+{
+    return sc_time_stamp().to_double() / GlobalParams::clock_period_ps - GlobalParams::reset_time;
+}
+
+bool SampledRun::stopped() const
+{
+    return sc_get_status() == SC_STOPPED;
+}
+
+void SampledRun::runFor(const double cycles)
+{
+    if (cycles > 0 && !stopped())
+    {
+	sc_start(cycles * GlobalParams::clock_period_ps, SC_PS);
+	covered += cycles;
+	detailed += cycles;
+    }
+}
+
+double SampledRun::averageHops() const
+{
+    vector<unsigned long> packets(pes.size());
+    double hops = 0;
+    unsigned long total = 0;
+
+    for (unsigned int dst = 0; dst < pes.size(); dst++)
+    {
+	fill(packets.begin(), packets.end(), 0);
+	noc->searchNode(pes[dst]->local_id)->r->stats.addReceivedPackets(packets);
+
+	for (unsigned int src = 0; src < pes.size(); src++)
+	{
+	    hops += (double) packets[src] * network.hops(pes[src]->local_id, pes[dst]->local_id);
+	    total += packets[src];
+	}
+    }
+
+    return total > 0 ? hops / total : 0;
+}
+
+Sample SampledRun::measure()
+{
+    Sample s;
+
+    // Detailed warming, then measurement
+    runFor(GlobalParams::sample_warm_cycles);
+
+    double start = now();
+    noc->resetStats(start);
+    s.start = covered;
+    runFor(GlobalParams::sample_measure_cycles);
+
+    // GlobalStats computes throughput over [stats_warm_up_time, simulation_time]
+    GlobalParams::stats_warm_up_time = start;
+    GlobalParams::simulation_time = now();
+
+    GlobalStats gs(noc);
+    s.packets = gs.getReceivedPackets();
+    s.avg_delay = s.packets > 0 ? gs.getAverageDelay() : 0;
+    s.throughput = gs.getThroughput();
+    received_flits += gs.getReceivedFlits();
+
+    // The fast-forward that follows delivers with the latency just measured
+    if (s.packets > 0)
+	network.calibrate(s.avg_delay, (double) gs.getReceivedFlits() / s.packets, averageHops());
+
+    return s;
+}
+
+void SampledRun::fastForward(const long cycles)
+{
+    if (cycles <= 0 || stopped())
+	return;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	pes[i]->fastForward(cycles, network);
+
+    covered += cycles;
+}
+
+void SampledRun::run()
+{
+    double period = GlobalParams::sample_period;
+    double window = GlobalParams::sample_warm_cycles + GlobalParams::sample_measure_cycles;
+
+    // Initial detailed warm-up of the empty network
+    runFor(GlobalParams::stats_warm_up_time);
+
+    while (covered + window <= horizon && !stopped())
+    {
+	samples.push_back(measure());
+
+	cout << "Sample " << samples.size() << " at cycle " << (long) samples.back().start
+	     << ": average delay " << samples.back().avg_delay
+	     << ", throughput " << samples.back().throughput << endl;
+
+	fastForward((long) min(period - window, horizon - covered));
+    }
+
+    // Time left shorter than a detailed window
+    fastForward((long) (horizon - covered));
+}
+
+void SampledRun::showResults(std::ostream & out) const
+{
+    vector<double> delays, throughputs;
+    for (unsigned int i = 0; i < samples.size(); i++)
+    {
+	// Windows without deliveries carry no delay information
+	if (samples[i].packets > 0)
+	    delays.push_back(samples[i].avg_delay);
+	throughputs.push_back(samples[i].throughput);
+    }
+
+    ConfidenceInterval delay = RunLengthController::batchMeans(delays);
+    ConfidenceInterval throughput = RunLengthController::batchMeans(throughputs);
+
+    out << endl;
+    out << "% Sampled simulation" << endl;
+    out << "% Sampling period (cycles): " << GlobalParams::sample_period
+	<< ", warming " << GlobalParams::sample_warm_cycles
+	<< ", measurement " << GlobalParams::sample_measure_cycles << endl;
+    out << "% Application cycles covered: " << covered << " (" << detailed
+	<< " detailed, " << 100 * detailed / max(covered, 1.0) << "%)" << endl;
+    out << "% Number of samples: " << samples.size() << endl;
+    out << "% Average delay 95% CI (cycles): " << delay.mean << " +/- " << delay.half_width
+	<< " (" << 100 * delay.relative() << "%)" << endl;
+    out << "% Average IP throughput 95% CI (flits/cycle/IP): " << throughput.mean << " +/- " << throughput.half_width
+	<< " (" << 100 * throughput.relative() << "%)" << endl;
+    if (samples.size() < RLC_MIN_BATCHES)
+	out << "% Warning: less than " << RLC_MIN_BATCHES << " samples, the confidence intervals are unreliable" << endl;
+
+    out << "% Fast-forwarded packets: " << network.packets << " (" << network.flits << " flits)" << endl;
+    if (network.packets > 0)
+	out << "% Fast-forward estimated average delay (cycles): " << network.delay_sum / network.packets
+	    << " (" << network.getHopCycles() << " cycles/hop)" << endl;
+}
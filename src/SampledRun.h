@@ -0,0 +1,74 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the sampled simulation
+ */
+
+#ifndef __NOXIMSAMPLEDRUN_H__
+#define __NOXIMSAMPLEDRUN_H__
+
+#include <iostream>
+#include <vector>
+
+#include "FunctionalNetwork.h"
+
+using namespace std;
+
+struct NoC;
+struct ProcessingElement;
+
+// One detailed measurement window
+struct Sample {
+    double start;		// cycle of the application timeline
+    double avg_delay;		// cycles
+    double throughput;		// flits/cycle/IP
+    unsigned long packets;
+};
+
+// Systematic sampling of a long run (SMARTS). Every sample_period cycles
+// of the application, the network is simulated in detail for
+// sample_warm_cycles, to refill it with the traffic of the current phase,
+// and then measured for sample_measure_cycles. The rest of the period is
+// fast-forwarded: the PEs hand their packets to a functional network,
+// while the detailed network is frozen in its last state
+class SampledRun {
+
+  public:
+
+    SampledRun(NoC * _noc);
+
+    // Runs until simulation_time cycles of the application are covered
+    void run();
+
+    // 95% confidence intervals over the samples and fast-forward totals
+    void showResults(std::ostream & out) const;
+
+    // Flits received in all the measurement windows
+    unsigned long getReceivedFlits() const { return received_flits; }
+
+  private:
+
+    NoC *noc;
+    vector<ProcessingElement*> pes;
+    FunctionalNetwork network;
+
+    double horizon;		// application cycles to cover
+    double covered;		// application cycles covered so far
+    double detailed;		// of which simulated in detail
+    unsigned long received_flits;
+
+    vector<Sample> samples;
+
+    double now() const;
+    bool stopped() const;
+    void runFor(const double cycles);
+    Sample measure();
+    double averageHops() const;
+    void fastForward(const long cycles);
+};
+
+#endif
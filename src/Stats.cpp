@@ -9,6 +9,9 @@
  */
 
 #include "Stats.h"
+#include "Profiler.h"
+#include "RunLengthController.h"
+#include "PacketTable.h"
 
 // TODO: nan in averageDelay
 
@@ -18,9 +21,72 @@ void Stats::configure(const int node_id, const double _warm_up_time)
     warm_up_time = _warm_up_time;
 }
 
+void Stats::reset(const double _warm_up_time)
+{
+    chist.clear();
+    warm_up_time = _warm_up_time;
+}
+
+void Stats::save(FILE * f) const
+{
+    unsigned int n = chist.size();
+    fwrite(&n, sizeof(n), 1, f);
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+	const CommHistory & ch = chist[i];
+	unsigned int n_delays = ch.delays.size();
+
+	fwrite(&ch.src_id, sizeof(ch.src_id), 1, f);
+	fwrite(&ch.total_received_flits, sizeof(ch.total_received_flits), 1, f);
+	fwrite(&ch.last_received_flit_time, sizeof(ch.last_received_flit_time), 1, f);
+	fwrite(&n_delays, sizeof(n_delays), 1, f);
+	if (n_delays > 0)
+	    fwrite(&ch.delays[0], sizeof(double), n_delays, f);
+    }
+}
+
+bool Stats::load(FILE * f)
+{
+    unsigned int n;
+    if (fread(&n, sizeof(n), 1, f) != 1)
+	return false;
+
+    chist.resize(n);
+    for (unsigned int i = 0; i < n; i++)
+    {
+	CommHistory & ch = chist[i];
+	unsigned int n_delays;
+
+	if (fread(&ch.src_id, sizeof(ch.src_id), 1, f) != 1 ||
+	    fread(&ch.total_received_flits, sizeof(ch.total_received_flits), 1, f) != 1 ||
+	    fread(&ch.last_received_flit_time, sizeof(ch.last_received_flit_time), 1, f) != 1 ||
+	    fread(&n_delays, sizeof(n_delays), 1, f) != 1)
+	    return false;
+
+	ch.delays.resize(n_delays);
+	if (n_delays > 0 && fread(&ch.delays[0], sizeof(double), n_delays, f) != n_delays)
+	    return false;
+    }
+
+    return true;
+}
+
 void Stats::receivedFlit(const double arrival_time,
 			      const Flit & flit)
 {
+    PROFILE_SCOPE(PROF_STATS);
+
+    double delay = arrival_time - PacketTable::timestamp(flit.packet_id);
+
+    // In packet mode the head stands for its whole packet, whose tail
+    // arrives sequence_length - 1 cycles later
+    unsigned int flits = GlobalParams::packet_mode ? flit.sequence_length : 1;
+
+    if (RunLengthController::enabled)
+	RunLengthController::receivedFlit(delay,
+					  flit.flit_type == FLIT_TYPE_HEAD, flits);
+
     if (arrival_time - GlobalParams::reset_time < warm_up_time)
 	return;
 
@@ -39,10 +105,10 @@ void Stats::receivedFlit(const double arrival_time,
     }
 
     if (flit.flit_type == FLIT_TYPE_HEAD)
-	chist[i].delays.push_back(arrival_time - flit.timestamp);
+	chist[i].delays.push_back(delay);
 
-    chist[i].total_received_flits++;
-    chist[i].last_received_flit_time = arrival_time - warm_up_time;
+    chist[i].total_received_flits += flits;
+    chist[i].last_received_flit_time = arrival_time + flits - 1 - warm_up_time;
 }
 
 double Stats::getAverageDelay(const int src_id)
@@ -154,6 +220,12 @@ unsigned int Stats::getReceivedFlits()
     return n;
 }
 
+void Stats::addReceivedPackets(vector<unsigned long> & packets) const
+{
+    for (unsigned int i = 0; i < chist.size(); i++)
+	packets[chist[i].src_id] += chist[i].delays.size();
+}
+
 unsigned int Stats::getTotalCommunications()
 {
     return chist.size();
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <cstdio>
 #include "DataStructs.h"
 #include "Power.h"
 using namespace std;
@@ -34,6 +35,9 @@ class Stats {
 
     void configure(const int node_id, const double _warm_up_time);
 
+    // Discards the collected history and restarts with a new warm-up
+    void reset(const double _warm_up_time);
+
     // Access point for stats update
     void receivedFlit(const double arrival_time, const Flit & flit);
 
@@ -64,6 +68,10 @@ class Stats {
     // Returns the number of received flits from current node
     unsigned int getReceivedFlits();
 
+    // Adds the number of packets received from each source to
+    // packets[src_id]
+    void addReceivedPackets(vector<unsigned long> & packets) const;
+
     // Returns the number of communications whose destination is the
     // current node
     unsigned int getTotalCommunications();
@@ -74,6 +82,11 @@ class Stats {
     // average between the minimum and the maximum packet size).
     double getCommunicationEnergy(int src_id, int dst_id);
 
+    // Raw copy of the collected history, used to gather the results of
+    // partitioned runs. load() returns false on a short read
+    void save(FILE * f) const;
+    bool load(FILE * f);
+
     // Shows statistics for the current node
     void showStats(int curr_node, std::ostream & out =
 		   std::cout, bool header = false);
@@ -0,0 +1,238 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the live terminal monitor
+ */
+
+#include "TerminalMonitor.h"
+#include "NoC.h"
+
+#include <sstream>
+#include <iomanip>
+
+#define ANSI_HOME        "\033[H"
+#define ANSI_CLEAR       "\033[2J"
+#define ANSI_CLEAR_LINE  "\033[K"
+#define ANSI_CLEAR_BELOW "\033[J"
+#define ANSI_RESET       "\033[0m"
+
+// Ten intensity levels, colored from green to red
+static const char *heat_chars = " .:-=+*#%@";
+static const char *heat_colors[10] = {
+    "\033[2m", "\033[32m", "\033[32m", "\033[32m", "\033[33m",
+    "\033[33m", "\033[33m", "\033[31m", "\033[31m", "\033[1;31m"
+};
+
+TerminalMonitor::TerminalMonitor(NoC * _noc)
+{
+    noc = _noc;
+    last_cycle = 0;
+    started = false;
+
+    buildLayout();
+
+    int n_routers = 0;
+    for (unsigned int i = 0; i < grid.size(); i++)
+	n_routers += grid[i].size();
+    last_forwarded.assign(n_routers * (DIRECTIONS + 2), 0);
+}
+
+void TerminalMonitor::buildLayout()
+{
+    if (GlobalParams::topology == TOPOLOGY_MESH)
+    {
+	layout_name = "mesh, rows=y columns=x";
+	grid.resize(GlobalParams::mesh_dim_y);
+	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
+	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
+		grid[y].push_back(noc->t[x][y]->r);
+    }
+    else
+    {
+	// One row per switch index: a slice of the cores first, then
+	// one column per stage of switches
+	int switches = GlobalParams::n_delta_switches;
+	int stages = GlobalParams::n_delta_stages;
+	int cores_per_row = (GlobalParams::n_delta_tiles + switches - 1) / switches;
+
+	layout_name = "delta, columns: cores then stages";
+	grid.resize(switches);
+	for (int k = 0; k < switches; k++)
+	{
+	    for (int c = 0; c < cores_per_row; c++)
+	    {
+		int id = k * cores_per_row + c;
+		grid[k].push_back(id < GlobalParams::n_delta_tiles ? noc->core[id]->r : NULL);
+	    }
+	    for (int s = 0; s < stages; s++)
+		grid[k].push_back(noc->t[s][k]->r);
+	}
+    }
+}
+
+string TerminalMonitor::cell(const double value)
+{
+    int level = (int) (value * 9 + 0.5);
+
+    if (level < 0) level = 0;
+    if (level > 9) level = 9;
+
+    string s = heat_colors[level];
+    s += heat_chars[level];
+    s += heat_chars[level];
+    s += ANSI_RESET;
+
+    return s;
+}
+
+void TerminalMonitor::update()
+{
+    Clock::time_point now = Clock::now();
+
+    if (!started)
+    {
+	first_frame = now;
+	started = true;
+	cout << ANSI_CLEAR;
+    }
+    else if (std::chrono::duration<double>(now - last_frame).count() < 1.0 / MONITOR_REFRESH_HZ)
+	return;
+
+    last_frame = now;
+
+    double cycle = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+    draw(cycle, std::chrono::duration<double>(now - first_frame).count());
+    last_cycle = cycle;
+}
+
+void TerminalMonitor::draw(const double cycle, const double elapsed)
+{
+    double cycles = cycle - last_cycle;
+    int rows = grid.size();
+    int cols = grid[0].size();
+
+    vector<vector<double> > occupancy(rows, vector<double>(cols, 0));
+    vector<vector<double> > link(rows, vector<double>(cols, 0));
+    vector<vector<double> > throughput(rows, vector<double>(cols, 0));
+    double max_throughput = 0;
+    double total_throughput = 0;
+
+    int idx = 0;
+    for (int i = 0; i < rows; i++)
+	for (int j = 0; j < cols; j++, idx++)
+	{
+	    Router *r = grid[i][j];
+	    if (r == NULL)
+		continue;
+
+	    // Buffer occupancy over all the input ports and virtual channels
+	    unsigned int used = 0, capacity = 0;
+	    for (int p = 0; p < DIRECTIONS + 2; p++)
+		for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
+		    if (r->buffer[p][vc].IsEnabled())
+		    {
+			used += r->buffer[p][vc].Size();
+			capacity += r->buffer[p][vc].GetMaxBufferSize();
+		    }
+	    occupancy[i][j] = capacity ? (double) used / capacity : 0;
+
+	    // Link utilisation is the one of the busiest output link,
+	    // throughput counts flits leaving the router through any port
+	    unsigned long forwarded = 0;
+	    double busiest = 0;
+	    for (int o = 0; o < DIRECTIONS + 2; o++)
+	    {
+		unsigned long &last = last_forwarded[idx * (DIRECTIONS + 2) + o];
+		unsigned long delta = r->forwarded_flits[o] - last;
+		last = r->forwarded_flits[o];
+
+		forwarded += delta;
+		if (o != DIRECTION_LOCAL && cycles > 0)
+		    busiest = max(busiest, delta / cycles);
+	    }
+	    link[i][j] = busiest;
+	    throughput[i][j] = cycles > 0 ? forwarded / cycles : 0;
+	    max_throughput = max(max_throughput, throughput[i][j]);
+	    total_throughput += throughput[i][j];
+	}
+
+    // Router throughput is shown relative to the busiest router
+    if (max_throughput > 0)
+	for (int i = 0; i < rows; i++)
+	    for (int j = 0; j < cols; j++)
+		throughput[i][j] /= max_throughput;
+
+    cout << ANSI_HOME;
+    cout << "Noxim monitor (" << layout_name << ")  cycle " << (long) cycle
+	 << "  " << fixed << setprecision(0) << (elapsed > 0 ? cycle / elapsed : 0) << " cycles/s"
+	 << ANSI_CLEAR_LINE << endl;
+    cout << "Legend: [" << heat_chars << "] = 0..100%,  max router throughput "
+	 << setprecision(2) << max_throughput << " flits/cycle,  total "
+	 << total_throughput << " flits/cycle" << ANSI_CLEAR_LINE << endl;
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6) << ANSI_CLEAR_LINE << endl;
+
+    vector<string> titles;
+    vector<vector<double> > values;
+    titles.push_back("Buffer occupancy");
+    titles.push_back("Link utilisation");
+    titles.push_back("Router throughput");
+
+    // Flatten the three maps, row after row
+    for (int m = 0; m < 3; m++)
+    {
+	vector<vector<double> > &map = (m == 0) ? occupancy : (m == 1) ? link : throughput;
+	vector<double> flat;
+	for (int i = 0; i < rows; i++)
+	    flat.insert(flat.end(), map[i].begin(), map[i].end());
+	values.push_back(flat);
+    }
+
+    drawHeatmaps(titles, values);
+    cout << ANSI_CLEAR_BELOW << flush;
+}
+
+void TerminalMonitor::drawHeatmaps(const vector<string> & titles, const vector<vector<double> > & values)
+{
+    int rows = grid.size();
+    int cols = grid[0].size();
+    int width = 2 * cols + 4;
+    bool side_by_side = (int) titles.size() * width <= MONITOR_MAX_WIDTH;
+
+    if (side_by_side)
+    {
+	for (unsigned int m = 0; m < titles.size(); m++)
+	    cout << setw(width) << left << titles[m].substr(0, width - 1);
+	cout << right << ANSI_CLEAR_LINE << endl;
+
+	for (int i = 0; i < rows; i++)
+	{
+	    for (unsigned int m = 0; m < titles.size(); m++)
+	    {
+		cout << "|";
+		for (int j = 0; j < cols; j++)
+		    cout << cell(values[m][i * cols + j]);
+		cout << "|  ";
+	    }
+	    cout << ANSI_CLEAR_LINE << endl;
+	}
+    }
+    else
+    {
+	for (unsigned int m = 0; m < titles.size(); m++)
+	{
+	    cout << titles[m] << ANSI_CLEAR_LINE << endl;
+	    for (int i = 0; i < rows; i++)
+	    {
+		cout << "|";
+		for (int j = 0; j < cols; j++)
+		    cout << cell(values[m][i * cols + j]);
+		cout << "|" << ANSI_CLEAR_LINE << endl;
+	    }
+	}
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the live terminal monitor
+ */
+
+#ifndef __NOXIMTERMINALMONITOR_H__
+#define __NOXIMTERMINALMONITOR_H__
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+
+using namespace std;
+
+// Screen refresh rate [Hz]
+#define MONITOR_REFRESH_HZ     10
+// The wall clock is checked once every MONITOR_CHECK_CYCLES simulated cycles
+#define MONITOR_CHECK_CYCLES   64
+// Maximum width of the screen before the heatmaps are stacked vertically
+#define MONITOR_MAX_WIDTH      132
+
+struct NoC;
+struct Router;
+
+class TerminalMonitor {
+
+  public:
+
+    TerminalMonitor(NoC * _noc);
+
+    // Redraws the screen if at least 1/MONITOR_REFRESH_HZ seconds elapsed
+    // since the previous frame
+    void update();
+
+  private:
+
+    typedef std::chrono::steady_clock Clock;
+
+    NoC *noc;
+
+    // Layout: grid[row][column] of the routers drawn (NULL: empty cell)
+    vector<vector<Router *> > grid;
+    string layout_name;
+
+    // Per output port forwarded flits at the previous frame, for each
+    // router of the grid in row-major order
+    vector<unsigned long> last_forwarded;
+    double last_cycle;
+
+    Clock::time_point last_frame;
+    Clock::time_point first_frame;
+    bool started;
+
+    void buildLayout();
+    void draw(const double cycle, const double elapsed);
+    void drawHeatmaps(const vector<string> & titles, const vector<vector<double> > & values);
+    static string cell(const double value);
+};
+
+#endif
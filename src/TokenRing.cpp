@@ -9,147 +9,226 @@
  */
 
 #include "TokenRing.h"
+#include "Profiler.h"
 
-void TokenRing::updateTokenPacket(int channel)
+TokenPolicy TokenRing::parsePolicy(int channel, const vector<string> & macPolicy)
 {
-    int token_pos = token_position[channel];
-    int token_holder = rings_mapping[channel][token_pos];
-    // TEST HOLD BUG
-	//if (flag[channel][token_pos]->read() == RELEASE_CHANNEL)
+    TokenPolicy policy;
 
-    if (flag[channel][token_holder]->read() == RELEASE_CHANNEL)
-	{
-	    // number of hubs of the ring
-	    int num_hubs = rings_mapping[channel].size();
+    if (macPolicy.empty())
+    {
+        cerr << "Error: missing MAC policy for channel " << channel << endl;
+        exit(1);
+    }
 
-	    token_position[channel] = (token_position[channel]+1)%num_hubs;
+    if (macPolicy[0] == TOKEN_PACKET)
+        policy.type = TOKEN_POLICY_PACKET;
+    else if (macPolicy[0] == TOKEN_HOLD)
+        policy.type = TOKEN_POLICY_HOLD;
+    else if (macPolicy[0] == TOKEN_MAX_HOLD)
+        policy.type = TOKEN_POLICY_MAX_HOLD;
+    else
+    {
+        cerr << "Error: invalid MAC policy " << macPolicy[0] << " for channel " << channel << endl;
+        exit(1);
+    }
 
-	    int new_token_holder = rings_mapping[channel][token_position[channel]];
-        LOG << "*** Token of channel " << channel << " has been assigned to Hub_" <<  new_token_holder << endl;
-	    current_token_holder[channel]->write(new_token_holder);
-	    // TEST HOLD BUG
-	    //flag[channel][token_position[channel]]->write(HOLD_CHANNEL);
-        flag[channel][new_token_holder]->write(HOLD_CHANNEL);
-	}
+    policy.hold_cycles = 0;
+    if (policy.type != TOKEN_POLICY_PACKET)
+    {
+        if (macPolicy.size() < 2)
+        {
+            cerr << "Error: MAC policy " << macPolicy[0] << " of channel " << channel << " requires the number of hold cycles" << endl;
+            exit(1);
+        }
+        policy.hold_cycles = atoi(macPolicy[1].c_str());
+    }
+
+    return policy;
 }
 
-void TokenRing::updateTokenMaxHold(int channel)
+int TokenRing::channelIndex(int channel) const
 {
-	if (--token_hold_count[channel] == 0 ||
-		flag[channel][token_position[channel]]->read() == RELEASE_CHANNEL)
-	{
-	    token_hold_count[channel] = atoi(GlobalParams::channel_configuration[channel].macPolicy[1].c_str());
-	    // number of hubs of the ring
-	    int num_hubs = rings_mapping[channel].size();
+    map<int,int>::const_iterator it = channel_index.find(channel);
+
+    assert(it != channel_index.end() && "Specified channel is not configured");
+    return it->second;
+}
+
+long TokenRing::currentCycle()
+{
+    return (long)(sc_time_stamp().to_double() / GlobalParams::clock_period_ps);
+}
+
+int TokenRing::getTokenExpiration(int ring_index) const
+{
+    const ChannelRing & ring = rings[ring_index];
+    long now = currentCycle();
+
+    assert(ring.policy.type != TOKEN_POLICY_PACKET);
+
+    // Hubs see the counter as it was after the previous clock edge, i.e.
+    // before a pass made by the ring in this same cycle
+    if (first_update < 0 || now <= first_update)
+        return 0;
+
+    long expire = (ring.pass_cycle == now) ? ring.prev_expire_cycle : ring.expire_cycle;
+
+    return expire - (now - 1);
+}
+
+void TokenRing::passToken(ChannelRing & ring)
+{
+    // number of hubs of the ring
+    int num_hubs = ring.hubs.size();
+
+    ring.position = (ring.position+1)%num_hubs;
+    LOG << "*** Token of channel " << ring.channel_id << " has been assigned to Hub_" <<  ring.hubs[ring.position] << endl;
+
+    ring.current_token_holder->write(ring.hubs[ring.position]);
+}
 
-	    token_position[channel] = (token_position[channel]+1)%num_hubs;
-	    LOG << "*** Token of channel " << channel << " has been assigned to Hub_" <<  rings_mapping[channel][token_position[channel]] << endl;
+void TokenRing::renewToken(ChannelRing & ring, long now)
+{
+    ring.prev_expire_cycle = ring.expire_cycle;
+    ring.expire_cycle = now + ring.policy.hold_cycles;
+    ring.pass_cycle = now;
+}
 
-	    current_token_holder[channel]->write(rings_mapping[channel][token_position[channel]]);
+bool TokenRing::updateTokenPacket(ChannelRing & ring)
+{
+    if (ring.flag[ring.position]->read() == RELEASE_CHANNEL)
+	{
+	    passToken(ring);
+	    ring.flag[ring.position]->write(HOLD_CHANNEL);
+	    return true;
 	}
 
-	current_token_expiration[channel]->write(token_hold_count[channel]);
+    return false;
 }
 
-void TokenRing::updateTokenHold(int channel)
+bool TokenRing::updateTokenMaxHold(ChannelRing & ring, long now)
 {
-	if (--token_hold_count[channel] == 0)
+	if (ring.expire_cycle == now ||
+		ring.flag[ring.position]->read() == RELEASE_CHANNEL)
 	{
-	    token_hold_count[channel] = atoi(GlobalParams::channel_configuration[channel].macPolicy[1].c_str());
-	    // number of hubs of the ring
-	    int num_hubs = rings_mapping[channel].size();
+	    renewToken(ring, now);
+	    passToken(ring);
+	    return true;
+	}
 
-	    token_position[channel] = (token_position[channel]+1)%num_hubs;
-	    LOG << "*** Token of channel " << channel << " has been assigned to Hub_" <<  rings_mapping[channel][token_position[channel]] << endl;
+	return false;
+}
 
-	    current_token_holder[channel]->write(rings_mapping[channel][token_position[channel]]);
+bool TokenRing::updateTokenHold(ChannelRing & ring, long now)
+{
+	if (ring.expire_cycle == now)
+	{
+	    renewToken(ring, now);
+	    passToken(ring);
+	    return true;
 	}
 
-	current_token_expiration[channel]->write(token_hold_count[channel]);
+	return false;
 }
 
 void TokenRing::updateTokens()
 {
+    PROFILE_SCOPE(PROF_TOKEN_RING);
+
     if (reset.read()) {
-        for (map<int,ChannelConfig>::iterator i = GlobalParams::channel_configuration.begin();
-             i!=GlobalParams::channel_configuration.end();
-             i++)
-            current_token_holder[i->first]->write(rings_mapping[i->first][0]);
+        for (unsigned int i = 0; i < rings.size(); i++)
+            if (!rings[i].hubs.empty())
+                rings[i].current_token_holder->write(rings[i].hubs[0]);
+        return;
     }
-    else
+
+    // Woken by the expiry timer or by a flag written after the last edge:
+    // tokens are only updated on the next rising edge
+    if (!clock.posedge())
     {
+        next_trigger(clock.posedge_event());
+        return;
+    }
 
-        for (map<int,ChannelConfig>::iterator i = GlobalParams::channel_configuration.begin(); i!=GlobalParams::channel_configuration.end(); i++)
-        {
-            int channel = i->first;
-            //int channel_holder;
-            //channel_holder = current_token_holder[channel]->read();
-
-            string macPolicy = getPolicy(channel).first;
-
-            if (macPolicy == TOKEN_PACKET)
-                updateTokenPacket(channel);
-            else if (macPolicy == TOKEN_HOLD)
-                updateTokenHold(channel);
-            else if (macPolicy == TOKEN_MAX_HOLD)
-                updateTokenMaxHold(channel);
-            else
-                assert(false);
-        }
+    long now = currentCycle();
+
+    if (first_update < 0)
+    {
+        // hold counters start on the first edge out of reset
+        first_update = now;
+        for (unsigned int i = 0; i < rings.size(); i++)
+            if (rings[i].policy.type != TOKEN_POLICY_PACKET)
+                rings[i].expire_cycle = now + rings[i].policy.hold_cycles - 1;
     }
-}
 
+    bool passed = false;
+    long next_expiry = -1;
 
-void TokenRing::attachHub(int channel, int hub, sc_in<int>* hub_token_holder_port, sc_in<int>* hub_token_expiration_port, sc_inout<int>* hub_flag_port)
-{
-    // If port for requested channel is not present, create the
-    // port and connect a signal
-    if (!current_token_holder[channel])
+    for (unsigned int i = 0; i < rings.size(); i++)
     {
-        token_position[channel] = 0;
-        // TEST HOLDBUG
-        //token_position[channel] = hub;
-        current_token_holder[channel] = new sc_out<int>();
-        current_token_expiration[channel] = new sc_out<int>();
+        ChannelRing & ring = rings[i];
 
-        token_holder_signals[channel] = new sc_signal<int>();
-        token_expiration_signals[channel] = new sc_signal<int>();
+        if (ring.hubs.empty())
+            continue;
 
-        current_token_holder[channel]->bind(*(token_holder_signals[channel]));
-        current_token_expiration[channel]->bind(*(token_expiration_signals[channel]));
+        switch (ring.policy.type)
+        {
+        case TOKEN_POLICY_PACKET:
+            passed |= updateTokenPacket(ring);
+            break;
+        case TOKEN_POLICY_HOLD:
+            passed |= updateTokenHold(ring, now);
+            break;
+        case TOKEN_POLICY_MAX_HOLD:
+            passed |= updateTokenMaxHold(ring, now);
+            break;
+        }
 
-        // initial value that will be overwritten if mac policy != TOKEN_PACKET
-        token_hold_count[channel] = 0;
+        if (ring.policy.type != TOKEN_POLICY_PACKET &&
+                (next_expiry < 0 || ring.expire_cycle < next_expiry))
+            next_expiry = ring.expire_cycle;
+    }
 
+    expiry_event.cancel();
+    if (next_expiry >= 0)
+        expiry_event.notify((next_expiry - now) * GlobalParams::clock_period_ps, SC_PS);
 
-        if (GlobalParams::channel_configuration[channel].macPolicy[0] != TOKEN_PACKET) {
-            // checking max hold cycles vs wireless transmission latency
-            // consistency
-            //TODO move this check: max_hold_cycles depends on the Channel not on the Hub
-            double delay_ps = 1000*GlobalParams::flit_size/GlobalParams::channel_configuration[channel].dataRate;
-            int cycles = ceil(delay_ps/GlobalParams::clock_period_ps);
-            int max_hold_cycles = atoi(GlobalParams::channel_configuration[channel].macPolicy[1].c_str());
-            assert(cycles< max_hold_cycles);
+    // The flag of a new holder may already be released, without any
+    // further change to wake the ring: check it on the next edge
+    if (passed)
+        next_trigger(clock.posedge_event());
+}
 
-            token_hold_count[channel] = atoi(GlobalParams::channel_configuration[channel].macPolicy[1].c_str());
-        }
+
+int TokenRing::attachHub(int channel, int hub, sc_in<int>* hub_token_holder_port, sc_inout<int>* hub_flag_port)
+{
+    int index = channelIndex(channel);
+    ChannelRing & ring = rings[index];
+
+    if (ring.hubs.empty() && ring.policy.type != TOKEN_POLICY_PACKET)
+    {
+        // checking max hold cycles vs wireless transmission latency
+        // consistency
+        //TODO move this check: max_hold_cycles depends on the Channel not on the Hub
+        double delay_ps = 1000*GlobalParams::flit_size/GlobalParams::channel_configuration[channel].dataRate;
+        int cycles = ceil(delay_ps/GlobalParams::clock_period_ps);
+        assert(cycles< ring.policy.hold_cycles);
     }
 
-    flag[channel][hub] = new sc_inout<int>();
-    flag_signals[channel][hub] = new sc_signal<int>();
-    flag[channel][hub]->bind(*(flag_signals[channel][hub]));
-    hub_flag_port->bind(*(flag_signals[channel][hub]));
+    // flags are created by the constructor, one for each hub of the
+    // channel
+    assert(ring.hubs.size() < ring.flag_signal.size());
+    hub_flag_port->bind(*ring.flag_signal[ring.hubs.size()]);
 
     // Connect tokenring to hub
-    hub_token_holder_port->bind(*(token_holder_signals[channel]));
-    hub_token_expiration_port->bind(*(token_expiration_signals[channel]));
+    hub_token_holder_port->bind(*ring.token_holder_signal);
 
     //LOG << "Attaching Hub " << hub << " to the token ring for channel " << channel << endl;
-    rings_mapping[channel].push_back(hub);
-
-    // TEST HOLD BUG
-    int starting_hub = rings_mapping[channel][0];
-    current_token_holder[channel]->write(starting_hub);
-}
+    ring.hubs.push_back(hub);
 
+    int starting_hub = ring.hubs[0];
+    ring.current_token_holder->write(starting_hub);
 
+    return index;
+}
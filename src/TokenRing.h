@@ -18,63 +18,134 @@
 
 using namespace std;
 
+// MAC policy of a wireless channel, parsed once from its macPolicy strings
+enum TokenPolicyType {
+    TOKEN_POLICY_PACKET,
+    TOKEN_POLICY_HOLD,
+    TOKEN_POLICY_MAX_HOLD
+};
+
+struct TokenPolicy {
+    TokenPolicyType type;
+    int hold_cycles;		// token hold cycles, unused by TOKEN_PACKET
+};
+
+// Token ring of a wireless channel
+struct ChannelRing {
+    int channel_id;
+    TokenPolicy policy;
+    vector<int> hubs;			// hubs of the ring, in token order
+    vector<sc_inout<int>*> flag;	// flag of each hub, same order
+    vector<sc_signal<int>*> flag_signal;
+    int position;			// token position in the ring
+    // TOKEN_HOLD and TOKEN_MAX_HOLD: cycle at which the token expires,
+    // its value before the last pass and the cycle of the last pass
+    long expire_cycle;
+    long prev_expire_cycle;
+    long pass_cycle;
+    sc_out<int>* current_token_holder;
+    sc_signal<int>* token_holder_signal;
+};
+
 SC_MODULE(TokenRing)
 {
     SC_HAS_PROCESS(TokenRing);
 
 
     // I/O Ports
-    sc_in_clk clock;	
+    sc_in_clk clock;
     sc_in < bool > reset;
 
-    map<int, sc_out<int>* > current_token_holder;
-    map<int, sc_out<int>* > current_token_expiration;
-    map<int, map<int,sc_inout<int>* > > flag;
-
-    map<int, sc_signal<int>* > token_holder_signals;
-    map<int, sc_signal<int>* > token_expiration_signals;
-    map<int, map<int, sc_signal<int>* > > flag_signals;
-
-
-
-    void attachHub(int channel, int hub, sc_in<int>* hub_token_holder_port, sc_in<int>* hub_token_expiration_port, sc_inout<int>* hub_flag_port);
+    // Returns the index of the ring of the channel, to be passed to
+    // getTokenExpiration()
+    int attachHub(int channel, int hub, sc_in<int>* hub_token_holder_port, sc_inout<int>* hub_flag_port);
 
+    // Tokens only change on the clock edges at which a token expires or
+    // a hub releases it: the process is woken by the expiry timer and by
+    // the flags of the hubs, and otherwise costs nothing per cycle
     void updateTokens();
 
     TokenRing(sc_module_name nm): sc_module(nm) {
 
+	first_update = -1;
 
 	if (GlobalParams::use_winoc)
 	{
 	    SC_METHOD(updateTokens);
 	    sensitive << reset;
-	    sensitive << clock.pos();
+	    sensitive << expiry_event;
 	}
 
-        for (map<int, ChannelConfig>::iterator i = GlobalParams::channel_configuration.begin(); 
+        // Flags are created here, as sensitivity can only be set while
+        // the module is being built: count the hubs of each channel
+        map<int,int> num_hubs;
+        for (map<int, HubConfig>::iterator h = GlobalParams::hub_configuration.begin();
+                h != GlobalParams::hub_configuration.end();
+                ++h)
+            for (unsigned int j = 0; j < h->second.txChannels.size(); j++)
+                num_hubs[h->second.txChannels[j]]++;
+
+        // Channel ids are remapped to the dense indices of rings
+        for (map<int, ChannelConfig>::iterator i = GlobalParams::channel_configuration.begin();
                 i != GlobalParams::channel_configuration.end();
                 ++i) {
-            token_policy[i->first] = make_pair(i->second.macPolicy[0], i->second.macPolicy); 
+            ChannelRing ring;
+
+            ring.channel_id = i->first;
+            ring.policy = parsePolicy(i->first, i->second.macPolicy);
+            ring.position = 0;
+            // set on the first clock edge out of reset
+            ring.expire_cycle = -1;
+            ring.prev_expire_cycle = -1;
+            ring.pass_cycle = -1;
+
+            ring.current_token_holder = new sc_out<int>();
+            ring.token_holder_signal = new sc_signal<int>();
+            ring.current_token_holder->bind(*ring.token_holder_signal);
+
+            for (int j = 0; j < num_hubs[i->first]; j++)
+            {
+                sc_inout<int>* flag = new sc_inout<int>();
+                sc_signal<int>* flag_signal = new sc_signal<int>();
+                flag->bind(*flag_signal);
+                ring.flag.push_back(flag);
+                ring.flag_signal.push_back(flag_signal);
+
+                // wake the ring when a hub releases the token (flags of
+                // TOKEN_HOLD rings are never read)
+                if (GlobalParams::use_winoc && ring.policy.type != TOKEN_POLICY_HOLD)
+                    sensitive << *flag_signal;
+            }
+
+            channel_index[i->first] = rings.size();
+            rings.push_back(ring);
         }
     }
 
-    pair<string, vector<string> > getPolicy(int channel) { return token_policy[channel];}
+    const TokenPolicy & getPolicy(int channel) { return rings[channelIndex(channel)].policy;}
+
+    // Cycles left to the current token holder of a TOKEN_HOLD or
+    // TOKEN_MAX_HOLD ring, as seen by the hubs in the current cycle
+    int getTokenExpiration(int ring_index) const;
 
     private:
 
-    void updateTokenMaxHold(int channel);
-    void updateTokenHold(int channel);
-    void updateTokenPacket(int channel);
+    bool updateTokenMaxHold(ChannelRing & ring, long now);
+    bool updateTokenHold(ChannelRing & ring, long now);
+    bool updateTokenPacket(ChannelRing & ring);
+    void passToken(ChannelRing & ring);
+    void renewToken(ChannelRing & ring, long now);
+    static long currentCycle();
+    int channelIndex(int channel) const;
+    static TokenPolicy parsePolicy(int channel, const vector<string> & macPolicy);
 
-    // ring of a channel -> list of pairs < hubs , hold counts >
-    map<int,vector<int> > rings_mapping;
+    vector<ChannelRing> rings;
 
-    // ring of a channel -> token position in the ring
-    map<int,int> token_position;
-    
-    map<int,int> token_hold_count;
+    sc_event expiry_event;	// notified at the earliest expire_cycle
+    long first_update;		// first clock edge out of reset
 
-    map<int,pair<string, vector<string> > >token_policy;
+    // channel id -> index in rings, only used at elaboration
+    map<int,int> channel_index;
 
 };
 
@@ -0,0 +1,440 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the port-level topology graph
+ */
+
+#include "Topology.h"
+#include "GlobalParams.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cassert>
+#include <deque>
+
+#define NO_PORT 0xFF
+
+static int ipow(const int base, const int exp)
+{
+    int r = 1;
+    for (int i = 0; i < exp; i++)
+	r *= base;
+    return r;
+}
+
+TopologyGraph::TopologyGraph()
+{
+    n_endpoints = 0;
+    n_stages = 0;
+    n_switches = 0;
+    radix = 0;
+    tail_length = 0;
+    from_netlist = false;
+}
+
+void TopologyGraph::addNode(const int id, const int type, const int x, const int y)
+{
+    TopologyNode n;
+
+    n.id = id;
+    n.type = type;
+    n.x = x;
+    n.y = y;
+
+    assert(id == (int) nodes.size());
+    nodes.push_back(n);
+    out_link.resize(nodes.size() * DIRECTIONS, NOT_VALID);
+}
+
+void TopologyGraph::addLink(const int src, const int src_port, const int dst, const int dst_port)
+{
+    TopologyLink l;
+
+    assert(src_port >= 0 && src_port < DIRECTIONS);
+    assert(dst_port >= 0 && dst_port < DIRECTIONS);
+    assert(out_link[src * DIRECTIONS + src_port] == NOT_VALID);
+
+    l.src = src;
+    l.src_port = src_port;
+    l.dst = dst;
+    l.dst_port = dst_port;
+
+    out_link[src * DIRECTIONS + src_port] = links.size();
+    links.push_back(l);
+}
+
+void TopologyGraph::buildMesh(const int dim_x, const int dim_y)
+{
+    n_endpoints = dim_x * dim_y;
+    radix = DIRECTIONS;
+
+    for (int y = 0; y < dim_y; y++)
+	for (int x = 0; x < dim_x; x++)
+	    addNode(y * dim_x + x, NODE_TILE, x, y);
+
+    // Each tx port reaches the opposite rx port of the neighbor
+    for (int y = 0; y < dim_y; y++)
+	for (int x = 0; x < dim_x; x++)
+	{
+	    int id = y * dim_x + x;
+
+	    if (y > 0)
+		addLink(id, DIRECTION_NORTH, id - dim_x, DIRECTION_SOUTH);
+	    if (x < dim_x - 1)
+		addLink(id, DIRECTION_EAST, id + 1, DIRECTION_WEST);
+	    if (y < dim_y - 1)
+		addLink(id, DIRECTION_SOUTH, id + dim_x, DIRECTION_NORTH);
+	    if (x > 0)
+		addLink(id, DIRECTION_WEST, id - 1, DIRECTION_EAST);
+	}
+}
+
+void TopologyGraph::initDelta(const int endpoints, const int stages, const int switches)
+{
+    n_endpoints = endpoints;
+    n_stages = stages;
+    n_switches = switches;
+
+    // Cores first, so that their id is the endpoint id, then the switches
+    // stage after stage (see coord2Id)
+    for (int i = 0; i < n_endpoints; i++)
+	addNode(i, NODE_CORE, 0, i);
+
+    for (int s = 0; s < n_stages; s++)
+	for (int j = 0; j < n_switches; j++)
+	    addNode(switchId(s, j), NODE_SWITCH, s, j);
+}
+
+int TopologyGraph::switchId(const int stage, const int index) const
+{
+    return n_endpoints + stage * n_switches + index;
+}
+
+int TopologyGraph::rotateLeft(const int line, const int digits) const
+{
+    int high = ipow(radix, digits - 1);
+
+    return (line % high) * radix + line / high;
+}
+
+int TopologyGraph::rotateRight(const int line, const int digits) const
+{
+    // Only the lowest digits are rotated, the others are kept
+    int block = ipow(radix, digits);
+    int low = line % block;
+
+    return line - low + low / radix + (low % radix) * (block / radix);
+}
+
+int TopologyGraph::switchRxPort(const int line) const
+{
+    if (radix == 2)
+	return (line % 2 == 0) ? DIRECTION_WEST : DIRECTION_SOUTH;
+
+    return line % radix;
+}
+
+int TopologyGraph::coreRxPort() const
+{
+    return (radix == 2) ? DIRECTION_EAST : 0;
+}
+
+void TopologyGraph::buildDelta(const string & type, const int endpoints, const int radix_)
+{
+    int stages = 0;
+    for (int n = 1; n < endpoints; n *= radix_)
+	stages++;
+
+    assert(ipow(radix_, stages) == endpoints);
+
+    radix = radix_;
+    initDelta(endpoints, stages, endpoints / radix);
+
+    // A line is identified by the address switch * radix + port. Every
+    // inter-stage pattern below keeps destination-tag routing valid: at
+    // stage s the output port is digit (stages - 1 - s) of the destination.
+    // With radix 2 the wiring is the one of the former hand-written
+    // builders, so that existing configurations give the same results
+
+    // Cores to the first stage
+    for (int c = 0; c < n_endpoints; c++)
+	addLink(c, 0, switchId(0, c / radix), switchRxPort(c));
+
+    // Stage to stage
+    for (int s = 0; s < n_stages - 1; s++)
+	for (int j = 0; j < n_switches; j++)
+	    for (int p = 0; p < radix; p++)
+	    {
+		int line = j * radix + p;
+		int next;
+
+		if (type == TOPOLOGY_OMEGA)
+		    // Perfect shuffle between stages
+		    next = rotateLeft(line, n_stages);
+		else if (type == TOPOLOGY_BASELINE && s == 0)
+		    // Inverse shuffle, then the stages of a butterfly
+		    next = rotateRight(line, n_stages);
+		else
+		{
+		    // Butterfly: exchange digit 0 with digit (stages - 1 - s)
+		    int weight = ipow(radix, n_stages - 1 - s);
+		    int digit = line / weight % radix;
+		    next = line - digit * weight + p * weight - p + digit;
+		}
+
+		addLink(switchId(s, j), p, switchId(s + 1, next / radix), switchRxPort(next));
+	    }
+
+    // Last stage to the cores
+    for (int j = 0; j < n_switches; j++)
+	for (int p = 0; p < radix; p++)
+	    addLink(switchId(n_stages - 1, j), p, j * radix + p, coreRxPort());
+}
+
+int TopologyGraph::parseNode(const char *name) const
+{
+    int a, b;
+    char tail;
+
+    if (sscanf(name, "c%d%c", &a, &tail) == 1)
+	return (a >= 0 && a < n_endpoints) ? a : NOT_VALID;
+
+    if (sscanf(name, "s%d.%d%c", &a, &b, &tail) == 2)
+	return (a >= 0 && a < n_stages && b >= 0 && b < n_switches) ? switchId(a, b) : NOT_VALID;
+
+    return NOT_VALID;
+}
+
+bool TopologyGraph::readNetlistSize(const char *fname, int & endpoints, int & stages, int & switches)
+{
+    ifstream fin(fname, ios::in);
+    if (!fin)
+	return false;
+
+    endpoints = stages = switches = 0;
+
+    while (!fin.eof()) {
+	char line[256];
+	int v;
+	fin.getline(line, sizeof(line) - 1);
+
+	if (line[0] == '\0' || line[0] == '%')
+	    continue;
+
+	if (sscanf(line, "endpoints %d", &v) == 1)
+	    endpoints = v;
+	else if (sscanf(line, "stages %d", &v) == 1)
+	    stages = v;
+	else if (sscanf(line, "switches %d", &v) == 1)
+	    switches = v;
+	else
+	    break;		// first link, the header is over
+    }
+
+    return endpoints > 0 && stages > 0 && switches > 0;
+}
+
+bool TopologyGraph::loadNetlist(const char *fname)
+{
+    int endpoints, stages, switches;
+
+    if (!readNetlistSize(fname, endpoints, stages, switches))
+    {
+	cerr << "Error: netlist " << fname << " must declare endpoints, stages and switches" << endl;
+	return false;
+    }
+
+    ifstream fin(fname, ios::in);
+    if (!fin)
+	return false;
+
+    initDelta(endpoints, stages, switches);
+    from_netlist = true;
+    radix = 0;
+
+    vector<bool> rx_used(nodes.size() * DIRECTIONS, false);
+    int line_number = 0;
+
+    while (!fin.eof()) {
+	char line[256];
+	fin.getline(line, sizeof(line) - 1);
+	line_number++;
+
+	if (line[0] == '\0' || line[0] == '%')
+	    continue;
+
+	char src_name[64], dst_name[64];
+	int v, src_port, dst_port;
+
+	if (sscanf(line, "endpoints %d", &v) == 1 ||
+	    sscanf(line, "stages %d", &v) == 1 ||
+	    sscanf(line, "switches %d", &v) == 1)
+	    continue;
+
+	if (sscanf(line, "%63s %d %63s %d", src_name, &src_port, dst_name, &dst_port) != 4)
+	{
+	    cerr << "Error: netlist " << fname << ", line " << line_number << ": expected SRC TX_PORT DST RX_PORT" << endl;
+	    return false;
+	}
+
+	int src = parseNode(src_name);
+	int dst = parseNode(dst_name);
+
+	if (src == NOT_VALID || dst == NOT_VALID)
+	{
+	    cerr << "Error: netlist " << fname << ", line " << line_number << ": unknown node" << endl;
+	    return false;
+	}
+
+	if (src_port < 0 || src_port >= DIRECTIONS || dst_port < 0 || dst_port >= DIRECTIONS)
+	{
+	    cerr << "Error: netlist " << fname << ", line " << line_number << ": ports must be in [0," << DIRECTIONS - 1 << "]" << endl;
+	    return false;
+	}
+
+	if (out_link[src * DIRECTIONS + src_port] != NOT_VALID || rx_used[dst * DIRECTIONS + dst_port])
+	{
+	    cerr << "Error: netlist " << fname << ", line " << line_number << ": port already connected" << endl;
+	    return false;
+	}
+
+	rx_used[dst * DIRECTIONS + dst_port] = true;
+	addLink(src, src_port, dst, dst_port);
+
+	if (nodes[src].type == NODE_SWITCH)
+	    radix = max(radix, src_port + 1);
+	if (nodes[dst].type == NODE_SWITCH)
+	    radix = max(radix, dst_port + 1);
+    }
+
+    return true;
+}
+
+void TopologyGraph::computePathTables(const int tail_hops)
+{
+    if (!from_netlist)
+    {
+	stage_divisor.resize(n_stages);
+	for (int s = 0; s < n_stages; s++)
+	    stage_divisor[s] = ipow(radix, n_stages - 1 - s);
+    }
+    else
+	computePortTable();
+
+    // Paths only depend on (src, dst): keep the nodes preceding each
+    // destination, as looked up by the hub relay of the routers
+    tail_length = tail_hops;
+    tail_table.assign(n_endpoints * n_endpoints * tail_length, NOT_VALID);
+
+    for (int src = 0; src < n_endpoints && tail_length > 0; src++)
+	for (int dst = 0; dst < n_endpoints; dst++)
+	{
+	    if (src == dst)
+		continue;
+
+	    vector<int> hops = path(src, dst);
+	    int * tail = &tail_table[(src * n_endpoints + dst) * tail_length];
+
+	    for (int h = 1; h <= tail_length && h < (int)hops.size(); h++)
+		tail[h - 1] = hops[hops.size() - 1 - h];
+	}
+}
+
+void TopologyGraph::computePortTable()
+{
+    // Reverse breadth-first search from every endpoint. Endpoints do not
+    // relay traffic, so paths only cross switches
+    vector<vector<int> > in_links(nodes.size());
+    for (unsigned int l = 0; l < links.size(); l++)
+	in_links[links[l].dst].push_back(l);
+
+    port_table.assign(nodes.size(), vector<unsigned char>(n_endpoints, NO_PORT));
+
+    for (int dst = 0; dst < n_endpoints; dst++)
+    {
+	deque<int> queue;
+	vector<bool> visited(nodes.size(), false);
+
+	queue.push_back(dst);
+	visited[dst] = true;
+
+	while (!queue.empty())
+	{
+	    int u = queue.front();
+	    queue.pop_front();
+
+	    for (unsigned int i = 0; i < in_links[u].size(); i++)
+	    {
+		const TopologyLink & l = links[in_links[u][i]];
+		if (visited[l.src])
+		    continue;
+
+		visited[l.src] = true;
+		port_table[l.src][dst] = l.src_port;
+		if (nodes[l.src].type == NODE_SWITCH)
+		    queue.push_back(l.src);
+	    }
+	}
+
+	for (int src = 0; src < n_endpoints; src++)
+	    if (src != dst && port_table[src][dst] == NO_PORT)
+	    {
+		cerr << "Error: netlist has no path from c" << src << " to c" << dst << endl;
+		exit(1);
+	    }
+    }
+}
+
+int TopologyGraph::nextPort(const int node, const int dst) const
+{
+    if (from_netlist)
+    {
+	int port = port_table[node][dst];
+	assert(port != NO_PORT);
+	return port;
+    }
+
+    assert(!stage_divisor.empty());
+
+    const TopologyNode & n = nodes[node];
+    if (n.type == NODE_CORE)
+	return 0;
+
+    return dst / stage_divisor[n.x] % radix;
+}
+
+int TopologyGraph::hopBefore(const int src, const int dst, const int hops) const
+{
+    assert(hops >= 1 && hops <= tail_length);
+
+    return tail_table[(src * n_endpoints + dst) * tail_length + hops - 1];
+}
+
+int TopologyGraph::neighbor(const int node, const int port) const
+{
+    int l = out_link[node * DIRECTIONS + port];
+
+    return (l == NOT_VALID) ? NOT_VALID : links[l].dst;
+}
+
+vector<int> TopologyGraph::path(const int src, const int dst) const
+{
+    vector<int> hops;
+    int current = src;
+
+    while (current != dst)
+    {
+	current = neighbor(current, nextPort(current, dst));
+	assert(current != NOT_VALID);
+	assert(hops.size() < nodes.size());
+	hops.push_back(current);
+    }
+
+    return hops;
+}
@@ -0,0 +1,117 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the port-level topology graph
+ */
+
+#ifndef __NOXIMTOPOLOGY_H__
+#define __NOXIMTOPOLOGY_H__
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+// Kind of the nodes of the topology graph
+#define NODE_TILE     0		// mesh tile: router and PE
+#define NODE_CORE     1		// endpoint of a delta network
+#define NODE_SWITCH   2		// switch of a delta network (no traffic)
+
+struct TopologyNode {
+    int id;			// local_id of the router and of the PE
+    int type;
+    int x;			// mesh column, or stage of a switch
+    int y;			// mesh row, index of a switch in its stage, or core id
+};
+
+// Unidirectional link from the tx port of a node to the rx port of another
+struct TopologyLink {
+    int src;
+    int src_port;
+    int dst;
+    int dst_port;
+};
+
+class TopologyGraph {
+
+  public:
+
+    TopologyGraph();
+
+    // Generators. Delta networks (BUTTERFLY, BASELINE, OMEGA) are built
+    // as k-ary n-stage networks of radix x radix switches
+    void buildMesh(const int dim_x, const int dim_y);
+    void buildDelta(const string & type, const int endpoints, const int radix);
+
+    // Loads a netlist file. Returns true if ok, false otherwise
+    bool loadNetlist(const char *fname);
+
+    // Reads only the size declared in the header of a netlist file
+    static bool readNetlistSize(const char *fname, int & endpoints, int & stages, int & switches);
+
+    // Builds the tables used by nextPort() and path(), and the tables of
+    // the last tail_hops nodes of every path used by hopBefore()
+    void computePathTables(const int tail_hops = 0);
+
+    // Output port to take at node to reach the endpoint dst
+    int nextPort(const int node, const int dst) const;
+
+    // Nodes traversed from src to dst, src excluded
+    vector<int> path(const int src, const int dst) const;
+
+    // Node found hops (1..tail_hops) before dst on the path from src to
+    // dst, NOT_VALID if the path is shorter
+    int hopBefore(const int src, const int dst, const int hops) const;
+
+    // Node reached through the tx port of node, NOT_VALID if unconnected
+    int neighbor(const int node, const int port) const;
+
+    vector<TopologyNode> nodes;		// indexed by id
+    vector<TopologyLink> links;
+
+    int n_endpoints;
+    int n_stages;
+    int n_switches;			// per stage
+    int radix;
+
+  private:
+
+    // Destination-tag routing of generated delta networks: the output
+    // port at stage s is the digit dst / stage_divisor[s] % radix
+    vector<int> stage_divisor;
+
+    // Shortest path routing of netlists: port_table[node][dst]
+    vector<vector<unsigned char> > port_table;
+
+    // tail_table[(src * n_endpoints + dst) * tail_length + hops - 1]
+    vector<int> tail_table;
+    int tail_length;
+
+    // out_link[node * DIRECTIONS + port]: link leaving from that tx port
+    vector<int> out_link;
+    bool from_netlist;
+
+    void computePortTable();
+    void addNode(const int id, const int type, const int x, const int y);
+    void addLink(const int src, const int src_port, const int dst, const int dst_port);
+    void initDelta(const int endpoints, const int stages, const int switches);
+    int switchId(const int stage, const int index) const;
+    int parseNode(const char *name) const;
+
+    // Shuffles of the digits of a line address for the delta generators
+    int rotateLeft(const int line, const int digits) const;
+    int rotateRight(const int line, const int digits) const;
+
+    // Rx port of the input of a switch reached by a line, and of the
+    // input of a core. Radix 2 keeps the ports of the former hand-written
+    // builders (WEST, SOUTH and EAST), on which the round-robin input
+    // arbitration depends
+    int switchRxPort(const int line) const;
+    int coreRxPort() const;
+};
+
+#endif
@@ -15,6 +15,7 @@
 #include <tlm>
 
 #include "DataStructs.h"
+#include "PacketTable.h"
 #include <iomanip>
 #include <sstream>
 
@@ -76,8 +77,8 @@ inline ostream & operator <<(ostream & os, const Flit & flit)
 	}
 	os << "Sequence no. " << flit.sequence_no << endl;
 	os << "Payload printing not implemented (yet)." << endl;
-	os << "Unix timestamp at packet generation " << flit.
-	    timestamp << endl;
+	os << "Unix timestamp at packet generation " <<
+	    PacketTable::timestamp(flit.packet_id) << endl;
 	os << "Total number of hops from source to destination is " <<
 	    flit.hop_no << endl;
     } else {
@@ -100,24 +101,13 @@ inline ostream & operator <<(ostream & os, const Flit & flit)
     return os;
 }
 
-inline ostream & operator <<(ostream & os,
-			     const ChannelStatus & status)
-{
-    char msg;
-    if (status.available)
-	msg = 'A';
-    else
-	msg = 'N';
-    os << msg << "(" << status.free_slots << ")";
-    return os;
-}
-
 inline ostream & operator <<(ostream & os, const NoP_data & NoP_data)
 {
     os << "      NoP data from [" << NoP_data.sender_id << "] [ ";
 
+    // A(free slots) for available channels, N(free slots) otherwise
     for (int j = 0; j < DIRECTIONS; j++)
-	os << NoP_data.channel_status_neighbor[j] << " ";
+	os << (NoP_data.isAvailable(j) ? 'A' : 'N') << "(" << NoP_data.free_slots[j] << ") ";
 
     os << "]" << endl;
     return os;
@@ -126,7 +116,7 @@ inline ostream & operator <<(ostream & os, const TBufferFullStatus & bfs)
 {
     os << "[" ;
     for (int j = 0; j < GlobalParams::n_virtual_channels; j++)
-	os << bfs.mask[j] << " ";
+	os << bfs.isFull(j) << " ";
 
     os << "]" << endl;
     return os;
@@ -146,7 +136,7 @@ inline void sc_trace(sc_trace_file * &tf, const Flit & flit, string & name)
     sc_trace(tf, flit.src_id, name + ".src_id");
     sc_trace(tf, flit.dst_id, name + ".dst_id");
     sc_trace(tf, flit.sequence_no, name + ".sequence_no");
-    sc_trace(tf, flit.timestamp, name + ".timestamp");
+    sc_trace(tf, flit.packet_id, name + ".packet_id");
     sc_trace(tf, flit.hop_no, name + ".hop_no");
 }
 
@@ -156,14 +146,7 @@ inline void sc_trace(sc_trace_file * &tf, const NoP_data & NoP_data, string & na
 }
 inline void sc_trace(sc_trace_file * &tf, const TBufferFullStatus & bfs, string & name)
 {
-    for (int j = 0; j < GlobalParams::n_virtual_channels; j++)
-	sc_trace(tf, bfs.mask[j], name + "VC "+to_string(j));
-}
-
-inline void sc_trace(sc_trace_file * &tf, const ChannelStatus & bs, string & name)
-{
-    sc_trace(tf, bs.free_slots, name + ".free_slots");
-    sc_trace(tf, bs.available, name + ".available");
+    sc_trace(tf, bfs.mask, name + ".mask", GlobalParams::n_virtual_channels);
 }
 
 // Misc common functions
@@ -171,7 +154,7 @@ inline void sc_trace(sc_trace_file * &tf, const ChannelStatus & bs, string & nam
 inline Coord id2Coord(int id)
 {
     Coord coord;
-    if (GlobalParams::topology == TOPOLOGY_MESH)
+    if (GlobalParams::topology_type == TOPOLOGY_TYPE_MESH)
     {
         coord.x = id % GlobalParams::mesh_dim_x;
         coord.y = id / GlobalParams::mesh_dim_x;
@@ -182,11 +165,11 @@ inline Coord id2Coord(int id)
     else // other delta topologies
     {
         id = id - GlobalParams::n_delta_tiles;
-        coord.x = id / (int)(GlobalParams::n_delta_tiles/2);
-        coord.y = id % (int)(GlobalParams::n_delta_tiles/2);
+        coord.x = id / GlobalParams::n_delta_switches;
+        coord.y = id % GlobalParams::n_delta_switches;
 
-        assert(coord.x < log2(GlobalParams::n_delta_tiles));
-        assert(coord.y < (GlobalParams::n_delta_tiles/2));
+        assert(coord.x < GlobalParams::n_delta_stages);
+        assert(coord.y < GlobalParams::n_delta_switches);
 
     }
     return coord;
@@ -195,14 +178,14 @@ inline Coord id2Coord(int id)
 inline int coord2Id(const Coord & coord)
 {
     int id;
-    if (GlobalParams::topology == TOPOLOGY_MESH)
+    if (GlobalParams::topology_type == TOPOLOGY_TYPE_MESH)
     {
         id = (coord.y * GlobalParams::mesh_dim_x) + coord.x;
         assert(id < GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y);
     }
     else
     {   //use only for switch bloc in delta topologies
-        id = (coord.x * (GlobalParams::n_delta_tiles/2)) + coord.y + GlobalParams::n_delta_tiles;
+        id = (coord.x * GlobalParams::n_delta_switches) + coord.y + GlobalParams::n_delta_tiles;
         assert(id > (GlobalParams::n_delta_tiles-1));
     }
 
@@ -254,7 +237,7 @@ template<typename T> std::string i_to_string(const T& t){
 
 inline bool YouAreSwitch(int id)
 {
-    if (id < (GlobalParams::n_delta_tiles/2) * log2(GlobalParams::n_delta_tiles))
+    if (id < GlobalParams::n_delta_switches * GlobalParams::n_delta_stages)
     return true;
     else return false;
 }
@@ -0,0 +1,109 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the wireless routing decision table
+ */
+
+#include "WirelessRoutingTable.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <map>
+
+WirelessRoutingTable::WirelessRoutingTable()
+{
+    n_src = 1;
+    n_dst = 0;
+}
+
+bool WirelessRoutingTable::connectedHubs(const int src_hub, const int dst_hub)
+{
+    const vector<int> &first = GlobalParams::hub_configuration[src_hub].txChannels;
+    const vector<int> &second = GlobalParams::hub_configuration[dst_hub].rxChannels;
+
+    for (unsigned int i = 0; i < first.size(); i++)
+	for (unsigned int j = 0; j < second.size(); j++)
+	    if (first[i] == second[j])
+		return true;
+
+    return false;
+}
+
+void WirelessRoutingTable::build(const TopologyGraph & topology)
+{
+    int n_nodes = topology.nodes.size();
+    int relay_hops = GlobalParams::winoc_dst_hops;
+
+    if (relay_hops > 0 && GlobalParams::topology_type == TOPOLOGY_TYPE_MESH)
+    {
+	cerr << "Error: relaying through hubs (winoc_dst_hops) is not supported on mesh topologies" << endl;
+	exit(1);
+    }
+
+    // Hub of each node, and dense indices of the hubs
+    vector<int> hub_of(n_nodes, NOT_VALID);
+    vector<int> row_hub;
+    map<int, int> rows;
+
+    hub_row.assign(n_nodes, NOT_VALID);
+    for (map<int, int>::iterator it = GlobalParams::hub_for_tile.begin();
+	 it != GlobalParams::hub_for_tile.end();
+	 ++it)
+    {
+	if (it->first < 0 || it->first >= n_nodes)
+	    continue;
+
+	if (rows.find(it->second) == rows.end())
+	{
+	    rows[it->second] = row_hub.size();
+	    row_hub.push_back(it->second);
+	}
+	hub_of[it->first] = it->second;
+	hub_row[it->first] = rows[it->second];
+    }
+
+    // Relay candidates come from paths, which are only known between
+    // endpoints, and packets are only addressed to endpoints
+    n_src = (relay_hops > 0) ? topology.n_endpoints : 1;
+    n_dst = topology.n_endpoints;
+    table.assign(row_hub.size() * n_src * n_dst, NOT_VALID);
+
+    for (unsigned int row = 0; row < row_hub.size(); row++)
+    {
+	int hub = row_hub[row];
+
+	for (int src = 0; src < n_src; src++)
+	    for (int dst = 0; dst < n_dst; dst++)
+	    {
+		int & entry = table[(row * n_src + src) * n_dst + dst];
+
+		// Destination directly connected to a reachable radio hub
+		if (hub_of[dst] != NOT_VALID && hub_of[dst] != hub &&
+		    connectedHubs(hub_of[dst], hub))
+		{
+		    entry = DIRECTION_HUB;
+		    continue;
+		}
+
+		if (relay_hops == 0 || src == dst)
+		    continue;
+
+		// Some node at most winoc_dst_hops before the destination
+		// has a hub other than the local one
+		for (int i = 1; i <= relay_hops; i++)
+		{
+		    int candidate_hop = topology.hopBefore(src, dst, i);
+		    if (candidate_hop != NOT_VALID && hub_of[candidate_hop] != NOT_VALID &&
+			hub_of[candidate_hop] != hub)
+		    {
+			entry = DIRECTION_HUB_RELAY + candidate_hop;
+			break;
+		    }
+		}
+	    }
+    }
+}
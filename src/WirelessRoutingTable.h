@@ -0,0 +1,60 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the wireless routing decision table
+ */
+
+#ifndef __NOXIMWIRELESSROUTINGTABLE_H__
+#define __NOXIMWIRELESSROUTINGTABLE_H__
+
+#include <vector>
+#include <cassert>
+#include "GlobalParams.h"
+#include "Topology.h"
+
+using namespace std;
+
+// Wireless routing decisions of the routers attached to a radio hub, built
+// once from the hub and channel configuration. They only depend on the hub
+// of the router, on the destination and, when packets may be relayed to a
+// node before the destination (winoc_dst_hops > 0), on the source
+class WirelessRoutingTable {
+
+  public:
+
+    WirelessRoutingTable();
+
+    // Needs the hub_for_tile map and the path tables of the topology
+    void build(const TopologyGraph & topology);
+
+    // DIRECTION_HUB, DIRECTION_HUB_RELAY + relay node, or NOT_VALID if
+    // the packet must take the wired network
+    int decision(const int local_id, const int src_id, const int dst_id) const {
+	int row = hub_row[local_id];
+	if (row == NOT_VALID)
+	    return NOT_VALID;
+	assert(dst_id < n_dst);
+	if (n_src == 1)
+	    return table[row * n_dst + dst_id];
+	return table[(row * n_src + src_id) * n_dst + dst_id];
+    }
+
+    // True if a channel goes from a tx port of src_hub to an rx port of
+    // dst_hub
+    static bool connectedHubs(const int src_hub, const int dst_hub);
+
+  private:
+
+    vector<int> hub_row;	// dense hub index of each node, NOT_VALID without hub
+    int n_src;			// sources per hub: 1 without relaying
+    int n_dst;			// destinations are always endpoints
+
+    // table[(hub_row * n_src + src) * n_dst + dst]
+    vector<int> table;
+};
+
+#endif
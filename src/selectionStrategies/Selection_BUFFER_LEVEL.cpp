@@ -12,36 +12,30 @@ Selection_BUFFER_LEVEL * Selection_BUFFER_LEVEL::getInstance() {
 }
 
 int Selection_BUFFER_LEVEL::apply(Router * router, const vector < int >&directions, const RouteData & route_data){
-    vector < int >best_dirs;
+    // best: the available directions whose neighbor has the highest
+    // number of free slots, in the order of the routing function
+    unsigned int available = router->reservation_table.notReservedMask();
+    int best[DIRECTIONS + 2];
+    unsigned int n_best = 0;
     int max_free_slots = 0;
-    for (unsigned int i = 0; i < directions.size(); i++) {
-
-	bool available = false;
 
-	int free_slots = router->free_slots_neighbor[directions[i]].read();
-
-	try {
-	    available = router->reservation_table.isNotReserved(directions[i]);
-	}
-	catch (int error)
-	{
-	    if (error==NOT_VALID) continue;
-	    assert(false);
-	}
+    assert(directions.size() <= DIRECTIONS + 2);
+    for (unsigned int i = 0; i < directions.size(); i++) {
+	if (!(available & (1u << directions[i])))
+	    continue;
 
+	int free_slots = router->link_tx[directions[i]]->readFreeSlots();
 
-	if (available) {
-	    if (free_slots > max_free_slots) {
-		max_free_slots = free_slots;
-		best_dirs.clear();
-		best_dirs.push_back(directions[i]);
-	    } else if (free_slots == max_free_slots)
-		best_dirs.push_back(directions[i]);
-	}
+	if (free_slots > max_free_slots) {
+	    max_free_slots = free_slots;
+	    n_best = 0;
+	    best[n_best++] = directions[i];
+	} else if (free_slots == max_free_slots)
+	    best[n_best++] = directions[i];
     }
 
-    if (best_dirs.size())
-	return (best_dirs[rand() % best_dirs.size()]);
+    if (n_best)
+	return best[rand() % n_best];
     else
 	return (directions[rand() % directions.size()]);
 
@@ -87,11 +81,11 @@ int Selection_BUFFER_LEVEL::apply(Router * router, const vector < int >&directio
 void Selection_BUFFER_LEVEL::perCycleUpdate(Router * router) {
 	    // update current input buffers level to neighbors
 	    for (int i = 0; i < DIRECTIONS + 1; i++)
-		router->free_slots[i].write(router->buffer[i][DEFAULT_VC].getCurrentFreeSlots());
+		router->link_rx[i]->writeFreeSlots(router->buffer[i][DEFAULT_VC].getCurrentFreeSlots());
 
 	    // NoP selection: send neighbor info to each direction 'i'
 	    NoP_data current_NoP_data = router->getCurrentNoPData();
 
 	    for (int i = 0; i < DIRECTIONS; i++)
-		router->NoP_data_out[i].write(current_NoP_data);
+		router->link_rx[i]->writeNoPData(current_NoP_data);
 }
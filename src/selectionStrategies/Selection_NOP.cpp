@@ -14,7 +14,6 @@ Selection_NOP * Selection_NOP::getInstance() {
 int Selection_NOP::apply(Router * router, const vector < int >&directions, const RouteData & route_data) {
     vector < int >neighbors_on_path;
     vector < int >score;
-    int direction_selected = NOT_VALID;
 
     int current_id = route_data.current_id;
 
@@ -34,44 +33,39 @@ int Selection_NOP::apply(Router * router, const vector < int >&directions, const
 	    router->routingFunction(tmp_route_data);
 
 	// select useful data from Neighbor-on-Path input 
-	NoP_data nop_tmp = router->NoP_data_in[directions[i]].read();
+	NoP_data nop_tmp = router->link_tx[directions[i]]->readNoPData();
 
 	// store the score of node in the direction[i]
 	score.push_back(router->NoPScore(nop_tmp, next_candidate_channels));
     }
 
     // check for direction with higher score
-    //int max_direction = directions[0];
     int max = score[0];
     for (unsigned int i = 0; i < directions.size(); i++) {
-	if (score[i] > max) {
-	//    max_direction = directions[i];
+	if (score[i] > max)
 	    max = score[i];
-	}
     }
 
     // if multiple direction have the same score = max, choose randomly.
+    int equivalent_directions[DIRECTIONS + 2];
+    unsigned int n_equivalent = 0;
 
-    vector < int >equivalent_directions;
-
+    assert(directions.size() <= DIRECTIONS + 2);
     for (unsigned int i = 0; i < directions.size(); i++)
 	if (score[i] == max)
-	    equivalent_directions.push_back(directions[i]);
-
-    direction_selected =
-	equivalent_directions[rand() % equivalent_directions.size()];
+	    equivalent_directions[n_equivalent++] = directions[i];
 
-    return direction_selected;
+    return equivalent_directions[rand() % n_equivalent];
 }
 
 void Selection_NOP::perCycleUpdate(Router * router) {
 	    // update current input buffers level to neighbors
 	    for (int i = 0; i < DIRECTIONS + 1; i++)
-		router->free_slots[i].write(router->buffer[i][DEFAULT_VC].getCurrentFreeSlots());
+		router->link_rx[i]->writeFreeSlots(router->buffer[i][DEFAULT_VC].getCurrentFreeSlots());
 
 	    // NoP selection: send neighbor info to each direction 'i'
 	    NoP_data current_NoP_data = router->getCurrentNoPData();
 
 	    for (int i = 0; i < DIRECTIONS; i++)
-		router->NoP_data_out[i].write(current_NoP_data);
+		router->link_rx[i]->writeNoPData(current_NoP_data);
 }